@@ -0,0 +1,142 @@
+// Subscription dispatch benchmark
+//
+// Cost of getting from a delivered NATS subject to the registered handler,
+// per message, for the two strategies ServiceHost has used:
+//
+//   subject lookup - rebuild the subject prefix, substr the type name out
+//                    of the subject and find it in the handler map
+//   bound slot     - the subscription's closure already points at the
+//                    handler entry (SubscriptionSlot)
+//
+// Both end in the same std::function call. The map holds as many message
+// types as a busy service registers; subjects cycle through all of them.
+// Reports nanoseconds and heap allocations per message, single-threaded.
+//
+// Usage: dispatch_benchmark [messages]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+} // namespace
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Entry {
+    std::function<void(size_t)> handler;
+};
+
+struct Slot {
+    const std::string* type_name;
+    const Entry* entry;
+};
+
+const char* const kTypes[] = {
+    "Trevor.HealthCheckRequest",   "Trevor.HealthCheckResponse", "Trevor.PortfolioRequest",
+    "Trevor.PortfolioResponse",    "Trevor.TradeRequest",        "Trevor.TradeResponse",
+    "Trevor.PriceUpdate",          "Trevor.PositionUpdate",      "Trevor.OrderStatus",
+    "Trevor.RiskLimitBreach",      "Trevor.MarketDataSnapshot",  "Trevor.AccountUpdate",
+};
+
+struct Result {
+    double ns = 0;
+    double allocs = 0;
+};
+
+template <typename Dispatch>
+Result measure(size_t messages, size_t types, Dispatch dispatch) {
+    const size_t allocations_before = allocations.load();
+    const auto start = Clock::now();
+    for (size_t i = 0; i < messages; ++i) {
+        dispatch(i % types, i);
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return {ns / messages, static_cast<double>(allocations.load() - allocations_before) / messages};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+    const std::string uid = "svc-portfolio-001";
+    const size_t types = sizeof(kTypes) / sizeof(kTypes[0]);
+
+    size_t sink = 0;
+    std::unordered_map<std::string, Entry> handlers;
+    for (const char* type : kTypes) {
+        handlers[type].handler = [&sink](size_t value) { sink += value; };
+    }
+
+    // Subjects as the NATS client hands them over, and one slot per subscription
+    std::vector<std::string> broadcast_subjects;
+    std::vector<std::string> direct_subjects;
+    std::vector<Slot> slots;
+    for (const char* type : kTypes) {
+        broadcast_subjects.push_back(std::string("system.broadcast.") + type);
+        direct_subjects.push_back("system.direct." + uid + "." + type);
+        auto it = handlers.find(type);
+        slots.push_back(Slot{&it->first, &it->second});
+    }
+
+    const Result broadcast_lookup = measure(messages, types, [&](size_t t, size_t i) {
+        std::string subj(broadcast_subjects[t].c_str());
+        std::string prefix = "system.broadcast.";
+        std::string type_name = subj.substr(prefix.size());
+        auto it = handlers.find(type_name);
+        if (it != handlers.end()) {
+            it->second.handler(i);
+        }
+    });
+    const Result direct_lookup = measure(messages, types, [&](size_t t, size_t i) {
+        std::string subject_str = direct_subjects[t].c_str();
+        std::string prefix = "system.direct." + uid + ".";
+        std::string type_name = subject_str.substr(prefix.length());
+        auto it = handlers.find(type_name);
+        if (it != handlers.end()) {
+            it->second.handler(i);
+        }
+    });
+    const Result bound = measure(messages, types, [&](size_t t, size_t i) {
+        const Slot* slot = &slots[t];
+        slot->entry->handler(i);
+    });
+
+    std::cout << "\n🚀 Subscription Dispatch Benchmark\n";
+    std::cout << "==================================\n";
+    std::cout << "Messages: " << messages << ", registered types: " << types << "\n\n";
+    std::cout << std::left << std::setw(28) << "strategy" << std::right << std::setw(12) << "ns/msg"
+              << std::setw(14) << "allocs/msg" << "\n";
+    auto row = [](const char* name, const Result& result) {
+        std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(12) << result.ns << std::setprecision(2)
+                  << std::setw(14) << result.allocs << "\n";
+    };
+    row("subject lookup (broadcast)", broadcast_lookup);
+    row("subject lookup (direct)", direct_lookup);
+    row("bound slot", bound);
+    return sink == 0 ? 1 : 0;
+}
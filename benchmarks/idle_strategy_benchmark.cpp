@@ -0,0 +1,143 @@
+// ThreadPool idle strategy benchmark
+//
+// Measures the wake-up latency of an idle pool (submit() -> task start) and
+// the CPU the pool burns while waiting, for plain park-on-condvar workers and
+// for spin-then-yield-then-park workers with growing spin budgets.
+//
+// A single producer submits one task every 'gap' microseconds, like a quiet
+// NATS subscription between market-data bursts. When the gap is longer than
+// the spin + yield budget the workers park anyway and the latency falls back
+// to the futex wake path, so run it with a few gaps to see the trade-off.
+// Run on a machine with more hardware threads than workers + 1: spinning
+// workers that share a core with the producer only delay it.
+//
+// Usage: idle_strategy_benchmark [messages] [gap_us]
+
+#include "thread_pool.hpp"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Mode = ThreadPool::SchedulingMode;
+
+struct Result {
+    double p50_us;
+    double p99_us;
+    double p999_us;
+    double cpu_cores;  // Pool CPU time / wall time while the run lasted
+};
+
+// 'who' is RUSAGE_SELF (whole process) or RUSAGE_THREAD (calling thread)
+double cpu_seconds(int who) {
+    rusage usage{};
+    getrusage(who, &usage);
+    auto seconds = [](const timeval& tv) { return tv.tv_sec + tv.tv_usec / 1e6; };
+    return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+}
+
+// Busy-wait so the producer's own sleep jitter does not blur the gap
+void pause_for(std::chrono::microseconds gap) {
+    auto until = Clock::now() + gap;
+    while (Clock::now() < until) {
+    }
+}
+
+Result run(Mode mode, size_t threads, std::chrono::microseconds spin,
+           std::chrono::microseconds yield, size_t messages, std::chrono::microseconds gap) {
+    ThreadPool::Options options;
+    options.threads = threads;
+    options.mode = mode;
+    options.idle_spin = spin;
+    options.idle_yield = yield;
+    ThreadPool pool(options);
+
+    std::vector<double> latency_us(messages);
+    std::atomic<size_t> completed{0};
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));  // Let workers go idle
+
+    const double cpu_start = cpu_seconds(RUSAGE_SELF);
+    const double producer_start = cpu_seconds(RUSAGE_THREAD);
+    const auto wall_start = Clock::now();
+    for (size_t i = 0; i < messages; ++i) {
+        auto submitted = Clock::now();
+        pool.submit([&latency_us, &completed, submitted, i]() {
+            latency_us[i] = std::chrono::duration<double, std::micro>(Clock::now() - submitted).count();
+            completed.fetch_add(1, std::memory_order_release);
+        });
+        pause_for(gap);
+    }
+    while (completed.load(std::memory_order_acquire) < messages) {
+        std::this_thread::yield();
+    }
+    const double wall = std::chrono::duration<double>(Clock::now() - wall_start).count();
+    // Everything but the busy-waiting producer is pool time
+    const double cpu = (cpu_seconds(RUSAGE_SELF) - cpu_start) -
+                       (cpu_seconds(RUSAGE_THREAD) - producer_start);
+    pool.shutdown();
+
+    std::sort(latency_us.begin(), latency_us.end());
+    auto pct = [&](double p) { return latency_us[static_cast<size_t>(p * (messages - 1))]; };
+    return {pct(0.50), pct(0.99), pct(0.999), std::max(0.0, cpu / wall)};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const auto gap = std::chrono::microseconds(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 50);
+    const size_t threads = 4;
+
+    struct Strategy {
+        std::string name;
+        std::chrono::microseconds spin;
+        std::chrono::microseconds yield;
+    };
+    const std::vector<Strategy> strategies = {
+        {"park", std::chrono::microseconds(0), std::chrono::microseconds(0)},
+        {"spin 10us", std::chrono::microseconds(10), std::chrono::microseconds(0)},
+        {"spin 50us", std::chrono::microseconds(50), std::chrono::microseconds(0)},
+        {"spin 50us+yield 200us", std::chrono::microseconds(50), std::chrono::microseconds(200)},
+        {"spin 500us", std::chrono::microseconds(500), std::chrono::microseconds(0)},
+    };
+
+    std::cout << "\n🚀 ThreadPool Idle Strategy Benchmark\n";
+    std::cout << "=====================================\n";
+    std::cout << "Messages: " << messages << ", gap: " << gap.count() << "us, workers: " << threads
+              << ", hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    std::cout << std::left << std::setw(15) << "mode"
+              << std::setw(24) << "strategy"
+              << std::right << std::setw(10) << "p50 us"
+              << std::setw(10) << "p99 us"
+              << std::setw(11) << "p99.9 us"
+              << std::setw(12) << "pool cores" << "\n";
+
+    for (Mode mode : {Mode::SharedQueue, Mode::WorkStealing}) {
+        for (const auto& strategy : strategies) {
+            Result r = run(mode, threads, strategy.spin, strategy.yield, messages, gap);
+            std::cout << std::left << std::setw(15)
+                      << (mode == Mode::WorkStealing ? "work-stealing" : "shared-queue")
+                      << std::setw(24) << strategy.name
+                      << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(10) << r.p50_us << std::setw(10) << r.p99_us
+                      << std::setw(11) << r.p999_us
+                      << std::setprecision(2) << std::setw(12) << r.cpu_cores << "\n";
+        }
+    }
+
+    std::cout << "=====================================\n";
+    std::cout << "Latency = submit() to task start. 'pool cores' excludes the producer.\n\n";
+    return 0;
+}
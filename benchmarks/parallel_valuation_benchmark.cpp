@@ -0,0 +1,188 @@
+// End-of-day valuation benchmark for parallel_algorithms.hpp
+//
+// Builds a synthetic book of Position records (the fields of
+// Trevor::Position, without protobuf) and times three passes over it:
+//
+//   revalue   - market_value / unrealized_pnl per position (parallel_for)
+//   totals    - book market value and P&L (parallel_transform_reduce)
+//   rank      - positions ordered by unrealized P&L (parallel_sort)
+//
+// Each pass runs serially, with the hand-rolled chunking it replaces
+// (one submit per fixed chunk plus an atomic countdown), and with the
+// parallel algorithms, at several pool sizes. Results only mean something
+// with at least as many hardware threads as pool threads.
+//
+// Usage: parallel_valuation_benchmark [positions]
+
+#include "parallel_algorithms.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Position {
+    uint32_t symbol_id;
+    double quantity;
+    double average_cost;
+    double current_price;
+    double market_value;
+    double unrealized_pnl;
+};
+
+struct Totals {
+    double market_value = 0;
+    double unrealized_pnl = 0;
+};
+
+Totals operator+(Totals a, const Totals& b) {
+    a.market_value += b.market_value;
+    a.unrealized_pnl += b.unrealized_pnl;
+    return a;
+}
+
+std::vector<Position> make_book(size_t count) {
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> price(5.0, 500.0);
+    std::uniform_real_distribution<double> drift(-0.1, 0.1);
+    std::uniform_int_distribution<int> quantity(-5000, 5000);
+    std::vector<Position> book(count);
+    for (size_t i = 0; i < count; ++i) {
+        const double cost = price(rng);
+        book[i] = Position{static_cast<uint32_t>(i % 5000), static_cast<double>(quantity(rng)), cost,
+                           cost * (1.0 + drift(rng)), 0.0, 0.0};
+    }
+    return book;
+}
+
+// A little more work than a multiply, like a real mark-to-market
+void revalue(Position& position) {
+    const double fx = 1.0 + 1e-4 * std::sin(static_cast<double>(position.symbol_id));
+    position.market_value = position.quantity * position.current_price * fx;
+    position.unrealized_pnl = position.market_value - position.quantity * position.average_cost * fx;
+}
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// What callers wrote before: fixed chunks, one submit each, spin on a countdown
+template <typename Body>
+void hand_rolled_for(ThreadPool& pool, size_t count, Body body) {
+    const size_t chunk = std::max<size_t>(1, count / (pool.size() * 4));
+    std::atomic<size_t> remaining{(count + chunk - 1) / chunk};
+    for (size_t begin = 0; begin < count; begin += chunk) {
+        const size_t end = std::min(count, begin + chunk);
+        pool.submit([&, begin, end]() {
+            for (size_t i = begin; i < end; ++i) {
+                body(i);
+            }
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+}
+
+struct Row {
+    double serial = 0;
+    double hand_rolled = 0;
+    double parallel = 0;
+};
+
+void print_row(const char* pass, size_t threads, const Row& row) {
+    std::cout << std::left << std::setw(10) << pass << std::right << std::setw(8) << threads
+              << std::fixed << std::setprecision(1) << std::setw(12) << row.serial
+              << std::setw(14) << row.hand_rolled << std::setw(12) << row.parallel
+              << std::setprecision(2) << std::setw(9) << row.serial / row.parallel << "x\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    const std::vector<Position> original = make_book(count);
+
+    std::cout << "\n🚀 Parallel Valuation Benchmark\n";
+    std::cout << "===============================\n";
+    std::cout << "Positions: " << count << ", hardware threads: "
+              << std::thread::hardware_concurrency() << "\n\n";
+    std::cout << std::left << std::setw(10) << "pass" << std::right << std::setw(8) << "threads"
+              << std::setw(12) << "serial ms" << std::setw(14) << "hand-rolled" << std::setw(12)
+              << "parallel" << std::setw(10) << "speedup" << "\n";
+
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        ThreadPool pool(threads, ThreadPool::SchedulingMode::WorkStealing);
+        std::vector<Position> book = original;
+        Row row;
+
+        auto start = Clock::now();
+        for (auto& position : book) {
+            revalue(position);
+        }
+        row.serial = ms_since(start);
+        start = Clock::now();
+        hand_rolled_for(pool, book.size(), [&](size_t i) { revalue(book[i]); });
+        row.hand_rolled = ms_since(start);
+        start = Clock::now();
+        parallel_for(pool, size_t{0}, book.size(), [&](size_t i) { revalue(book[i]); });
+        row.parallel = ms_since(start);
+        print_row("revalue", threads, row);
+
+        auto totals_of = [](const Position& p) { return Totals{p.market_value, p.unrealized_pnl}; };
+        start = Clock::now();
+        Totals serial_totals;
+        for (const auto& position : book) {
+            serial_totals = serial_totals + totals_of(position);
+        }
+        row.serial = ms_since(start);
+        start = Clock::now();
+        std::vector<Totals> partial(book.size());
+        hand_rolled_for(pool, book.size(), [&](size_t i) { partial[i] = totals_of(book[i]); });
+        Totals hand_totals;
+        for (const auto& p : partial) {
+            hand_totals = hand_totals + p;
+        }
+        row.hand_rolled = ms_since(start);
+        start = Clock::now();
+        Totals totals = parallel_transform_reduce(pool, book.begin(), book.end(), Totals{},
+                                                  std::plus<>(), totals_of);
+        row.parallel = ms_since(start);
+        if (std::abs(totals.unrealized_pnl - serial_totals.unrealized_pnl) >
+            1e-6 * std::abs(serial_totals.market_value)) {
+            std::cerr << "totals mismatch\n";
+            return 1;
+        }
+        print_row("totals", threads, row);
+
+        auto by_pnl = [](const Position& a, const Position& b) { return a.unrealized_pnl < b.unrealized_pnl; };
+        std::vector<Position> ranked = book;
+        start = Clock::now();
+        std::sort(ranked.begin(), ranked.end(), by_pnl);
+        row.serial = ms_since(start);
+        row.hand_rolled = 0;  // Nobody hand-rolled a parallel sort
+        ranked = book;
+        start = Clock::now();
+        parallel_sort(pool, ranked.begin(), ranked.end(), by_pnl);
+        row.parallel = ms_since(start);
+        if (!std::is_sorted(ranked.begin(), ranked.end(), by_pnl)) {
+            std::cerr << "rank not sorted\n";
+            return 1;
+        }
+        print_row("rank", threads, row);
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+// ServiceHost publish path benchmark
+//
+// 1, 2, 4 and 8 threads publish PortfolioResponse messages (10 positions)
+// as fast as they can; reported are total messages per second and heap
+// allocations per message (global operator new is counted). Two paths:
+//
+//   global mutex  the publish path before thread-local buffers: one
+//                 service-wide mutex held around GetTypeName(),
+//                 SerializeToString() into a fresh std::string, subject
+//                 concatenation, the publish and the metrics updates
+//   ServiceHost   publish_broadcast() (tracing disabled): serialized
+//                 outside any lock into the thread's reusable buffer
+//
+// Both publish on their own connection to a subject nobody subscribes to,
+// so the server discards the messages and only the client side is timed.
+//
+// Needs a nats-server at NATS_URL or nats://localhost:4222.
+//
+// Usage: publish_benchmark [messages_per_thread]
+
+#include "logger.hpp"
+#include "messages.pb.h"
+#include "service_host.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+} // namespace
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+Trevor::PortfolioResponse make_response(int positions) {
+    Trevor::PortfolioResponse response;
+    response.set_account_id("ACC-000123");
+    response.set_total_value(1250000.0);
+    response.set_cash_balance(50000.0);
+    response.set_status("active");
+    for (int i = 0; i < positions; ++i) {
+        auto* position = response.add_positions();
+        position->set_symbol("SYM" + std::to_string(i));
+        position->set_quantity(100 + i);
+        position->set_average_cost(42.5);
+        position->set_current_price(43.0);
+    }
+    return response;
+}
+
+ServiceInitConfig bench_config(const std::string& url) {
+    ServiceInitConfig config;
+    config.nats_url = url;
+    config.enable_jetstream = false;
+    config.enable_cache = false;
+    config.enable_scheduler = false;
+    config.enable_permanent_tasks = false;
+    config.enable_metrics_server = false;
+    return config;
+}
+
+// The previous publish_broadcast_fast, lock and metrics included
+class MutexPublisher {
+public:
+    explicit MutexPublisher(natsConnection* conn) : conn_(conn) {}
+
+    void publish(const google::protobuf::Message& message) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::string type_name = message.GetTypeName();
+        std::string data;
+        if (!message.SerializeToString(&data)) {
+            return;
+        }
+        std::string subject = "broadcast." + type_name;
+        if (natsConnection_Publish(conn_, subject.c_str(), data.c_str(), static_cast<int>(data.length())) == NATS_OK) {
+            sent_.inc();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - start_time);
+            duration_.observe(duration.count() / 1000000.0);
+        }
+    }
+
+private:
+    natsConnection* conn_;
+    std::mutex mutex_;
+    PrometheusMetrics::Counter sent_{"bench_sent_total", "Messages sent"};
+    PrometheusMetrics::Histogram duration_{
+        "bench_publish_duration_seconds", "Publish time",
+        {0.0001, 0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0}};
+};
+
+void run(const char* name, size_t threads, size_t per_thread,
+         const std::function<void(const google::protobuf::Message&)>& publish) {
+    const Trevor::PortfolioResponse message = make_response(10);
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> publishers;
+
+    for (size_t t = 0; t < threads; ++t) {
+        publishers.emplace_back([&]() {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < per_thread; ++i) {
+                publish(message);
+            }
+        });
+    }
+    while (ready.load() < threads) {
+        std::this_thread::yield();
+    }
+
+    const size_t allocations_before = allocations.load();
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& publisher : publishers) {
+        publisher.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const double total = static_cast<double>(threads * per_thread);
+    const double per_message = static_cast<double>(allocations.load() - allocations_before) / total;
+
+    std::cout << std::left << std::setw(16) << name << std::right << std::setw(8) << threads
+              << std::fixed << std::setprecision(0) << std::setw(14) << total / seconds
+              << std::setprecision(2) << std::setw(14) << per_message << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t per_thread = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const char* env_url = std::getenv("NATS_URL");
+    const std::string url = env_url ? env_url : "nats://localhost:4222";
+    Logger::set_level(Logger::Level::WARN);
+
+    natsConnection* conn = nullptr;
+    if (natsConnection_ConnectTo(&conn, url.c_str()) != NATS_OK) {
+        std::cerr << "No NATS server at " << url << "\n";
+        return 1;
+    }
+    MutexPublisher baseline(conn);
+
+    ServiceHost host("bench-publish-001", "PublishBenchmark");
+    host.StartService(bench_config(url));
+    host.disable_tracing();
+
+    std::cout << std::setfill(' ') << "\n🚀 ServiceHost Publish Benchmark\n";
+    std::cout << "================================\n";
+    std::cout << "Messages per thread: " << per_thread << ", payload "
+              << make_response(10).ByteSizeLong() << " bytes\n\n";
+    std::cout << std::left << std::setw(16) << "path" << std::right << std::setw(8) << "threads"
+              << std::setw(14) << "msgs/s" << std::setw(14) << "allocs/msg" << "\n";
+
+    for (size_t threads : {1, 2, 4, 8}) {
+        run("global mutex", threads, per_thread,
+            [&](const google::protobuf::Message& message) { baseline.publish(message); });
+        run("ServiceHost", threads, per_thread,
+            [&](const google::protobuf::Message& message) { host.publish_broadcast(message); });
+    }
+
+    host.shutdown();
+    natsConnection_Destroy(conn);
+    return 0;
+}
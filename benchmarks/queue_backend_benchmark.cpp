@@ -0,0 +1,211 @@
+// ThreadPool queue backend benchmark
+//
+// Part 1 compares the raw queues: MpmcRing against a mutex-guarded deque
+// (what SharedQueue uses) with P producers and C consumers hammering one
+// queue, reporting transfers per second. Both are bounded to the same
+// capacity and both callers spin-yield on full/empty, so the difference is
+// the cost of the lock versus one CAS per operation under contention.
+//
+// Part 2 runs the same shape through ThreadPool itself: P external threads
+// submit tiny tasks to a C-worker pool in SharedQueue, WorkStealing and
+// LockFreeRing mode, and reports tasks per second until all have run.
+// Results only mean something with at least P + C hardware threads.
+//
+// Usage: queue_backend_benchmark [items_per_producer]
+
+#include "mpmc_ring.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Mode = ThreadPool::SchedulingMode;
+
+constexpr size_t kCapacity = 4096;
+
+// The SharedQueue baseline: one mutex around a bounded deque
+class MutexQueue {
+public:
+    explicit MutexQueue(size_t capacity) : capacity_(capacity) {}
+
+    bool try_push(size_t value) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (items_.size() == capacity_) {
+            return false;
+        }
+        items_.push_back(value);
+        return true;
+    }
+
+    bool try_pop(size_t& value) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (items_.empty()) {
+            return false;
+        }
+        value = items_.front();
+        items_.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mtx_;
+    std::deque<size_t> items_;
+    const size_t capacity_;
+};
+
+// Million transfers per second through 'queue'
+template <typename Queue>
+double run_queue(Queue& queue, size_t producers, size_t consumers, size_t per_producer) {
+    const size_t total = producers * per_producer;
+    std::atomic<size_t> consumed{0};
+    std::atomic<size_t> checksum{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            for (size_t i = 1; i <= per_producer; ++i) {
+                while (!queue.try_push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            size_t value = 0;
+            size_t sum = 0;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (queue.try_pop(value)) {
+                    sum += value;
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            checksum.fetch_add(sum);
+        });
+    }
+
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (checksum.load() != producers * per_producer * (per_producer + 1) / 2) {
+        std::cerr << "checksum mismatch\n";
+        std::exit(1);
+    }
+    return total / seconds / 1e6;
+}
+
+// Million tasks per second submitted by 'producers' external threads
+double run_pool(Mode mode, size_t producers, size_t workers, size_t per_producer) {
+    ThreadPool::Options options;
+    options.threads = workers;
+    options.mode = mode;
+    ThreadPool pool(options);
+
+    const size_t total = producers * per_producer;
+    std::atomic<size_t> completed{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            for (size_t i = 0; i < per_producer; ++i) {
+                pool.submit([&completed]() { completed.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+
+    const auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    while (completed.load(std::memory_order_relaxed) < total) {
+        std::this_thread::yield();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    pool.shutdown();
+    return total / seconds / 1e6;
+}
+
+const char* mode_name(Mode mode) {
+    switch (mode) {
+    case Mode::SharedQueue:
+        return "shared-queue";
+    case Mode::WorkStealing:
+        return "work-stealing";
+    case Mode::LockFreeRing:
+        return "lock-free-ring";
+    }
+    return "?";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t per_producer = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const std::vector<std::pair<size_t, size_t>> shapes = {{1, 1}, {1, 4}, {4, 1}, {2, 2}, {4, 4}, {8, 8}};
+
+    std::cout << "\n🚀 ThreadPool Queue Backend Benchmark\n";
+    std::cout << "=====================================\n";
+    std::cout << "Items per producer: " << per_producer << ", capacity: " << kCapacity
+              << ", hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    std::cout << "Raw queue (M transfers/s)\n";
+    std::cout << std::left << std::setw(12) << "prod x cons"
+              << std::right << std::setw(14) << "mutex+deque"
+              << std::setw(14) << "mpmc ring"
+              << std::setw(10) << "speedup" << "\n";
+    for (const auto& [producers, consumers] : shapes) {
+        MutexQueue locked(kCapacity);
+        MpmcRing<size_t> ring(kCapacity);
+        const double mutex_rate = run_queue(locked, producers, consumers, per_producer);
+        const double ring_rate = run_queue(ring, producers, consumers, per_producer);
+        std::cout << std::left << std::setw(12)
+                  << (std::to_string(producers) + " x " + std::to_string(consumers))
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << mutex_rate << std::setw(14) << ring_rate
+                  << std::setw(9) << ring_rate / mutex_rate << "x\n";
+    }
+
+    std::cout << "\nThreadPool submit -> run (M tasks/s)\n";
+    std::cout << std::left << std::setw(12) << "prod x wrk";
+    for (Mode mode : {Mode::SharedQueue, Mode::WorkStealing, Mode::LockFreeRing}) {
+        std::cout << std::right << std::setw(16) << mode_name(mode);
+    }
+    std::cout << "\n";
+    for (const auto& [producers, workers] : shapes) {
+        std::cout << std::left << std::setw(12)
+                  << (std::to_string(producers) + " x " + std::to_string(workers));
+        for (Mode mode : {Mode::SharedQueue, Mode::WorkStealing, Mode::LockFreeRing}) {
+            std::cout << std::right << std::fixed << std::setprecision(2) << std::setw(16)
+                      << run_pool(mode, producers, workers, per_producer);
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "=====================================\n\n";
+    return 0;
+}
@@ -0,0 +1,107 @@
+// ServiceHost receive path benchmark
+//
+// Feeds serialized PortfolioResponse messages (0, 10 and 100 positions)
+// through ServiceHost::receive_message() into a register_message handler
+// and reports heap allocations per message (global operator new is
+// counted) and messages per second. The payload is one shared
+// MessageBuffer, standing in for the natsMsg a subscription adopts, so
+// every allocation counted is made by the receive path itself: receive
+// job, parse, dispatch and handler bookkeeping.
+//
+// No NATS server is needed; messages are injected directly.
+//
+// Usage: receive_path_benchmark [messages]
+
+#include "logger.hpp"
+#include "messages.pb.h"
+#include "service_host.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <thread>
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+} // namespace
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string make_response(int positions) {
+    Trevor::PortfolioResponse response;
+    response.set_account_id("ACC-000123");
+    response.set_total_value(1250000.0);
+    response.set_cash_balance(50000.0);
+    response.set_status("active");
+    for (int i = 0; i < positions; ++i) {
+        auto* position = response.add_positions();
+        position->set_symbol("SYM" + std::to_string(i));
+        position->set_quantity(100 + i);
+        position->set_average_cost(42.5);
+        position->set_current_price(43.0);
+    }
+    return response.SerializeAsString();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    Logger::set_level(Logger::Level::WARN);
+
+    ServiceHost host("bench-receive-001", "ReceiveBenchmark");
+    std::atomic<size_t> handled{0};
+    std::atomic<size_t> checksum{0};
+    host.register_message<Trevor::PortfolioResponse>(
+        MessageRouting::Broadcast, [&](const Trevor::PortfolioResponse& response) {
+            checksum.fetch_add(static_cast<size_t>(response.positions_size()), std::memory_order_relaxed);
+            handled.fetch_add(1, std::memory_order_release);
+        });
+    const std::string type_name = Trevor::PortfolioResponse::descriptor()->full_name();
+
+    std::cout << "\n🚀 ServiceHost Receive Path Benchmark\n";
+    std::cout << "=====================================\n";
+    std::cout << "Messages per run: " << messages << "\n\n";
+    std::cout << std::left << std::setw(12) << "positions" << std::right << std::setw(14) << "bytes"
+              << std::setw(16) << "allocs/msg" << std::setw(14) << "msgs/s" << "\n";
+
+    for (int positions : {0, 10, 100}) {
+        const MessageBuffer payload = MessageBuffer::copy_of(make_response(positions));
+        handled = 0;
+
+        const size_t allocations_before = allocations.load();
+        const auto start = Clock::now();
+        for (size_t i = 0; i < messages; ++i) {
+            host.receive_message(type_name, payload);
+        }
+        while (handled.load(std::memory_order_acquire) < messages) {
+            std::this_thread::yield();
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        const double per_message =
+            static_cast<double>(allocations.load() - allocations_before) / static_cast<double>(messages);
+
+        std::cout << std::left << std::setw(12) << positions << std::right << std::setw(14)
+                  << payload.size() << std::fixed << std::setprecision(2) << std::setw(16)
+                  << per_message << std::setprecision(0) << std::setw(14) << messages / seconds << "\n";
+    }
+    return checksum.load() > 0 ? 0 : 1;
+}
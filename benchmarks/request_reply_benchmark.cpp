@@ -0,0 +1,235 @@
+// ServiceHost request/reply benchmark
+//
+// One ServiceHost answers HealthCheckRequest through
+// register_request_handler; another sends requests to it. Two ways of
+// waiting for the reply are compared:
+//
+//   shared inbox  ServiceHost::request<Req, Resp>: one inbox subscription
+//                 for all requests, replies matched by correlation id
+//   per-call sub  a fresh inbox subscribed (with a timeout) for each
+//                 request and torn down by its reply, as request_async
+//                 used to do
+//
+// Latency: one request at a time, percentiles of the round trip.
+// Concurrency: 'window' requests kept in flight, completed requests per
+// second; the per-call variant pays a subscribe and an unsubscribe per
+// request on the same connection.
+//
+// Needs a nats-server at NATS_URL or nats://localhost:4222.
+//
+// Usage: request_reply_benchmark [requests]
+
+#include "logger.hpp"
+#include "messages.pb.h"
+#include "service_host.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Request = Trevor::HealthCheckRequest;
+using Response = Trevor::HealthCheckResponse;
+
+ServiceInitConfig bench_config(const std::string& url) {
+    ServiceInitConfig config;
+    config.nats_url = url;
+    config.enable_jetstream = false;
+    config.enable_cache = false;
+    config.enable_scheduler = false;
+    config.enable_permanent_tasks = false;
+    config.enable_metrics_server = false;
+    return config;
+}
+
+// Per-call subscription: the reply or the timeout fires the callback once
+TaskFuture<Response> per_call_request(natsConnection* conn, ThreadPool& pool, const std::string& subject,
+                                      const std::string& payload, std::chrono::milliseconds timeout) {
+    using Promise = std::shared_ptr<TaskPromise<Response>>;
+    auto promise = std::make_shared<TaskPromise<Response>>(&pool);
+    TaskFuture<Response> reply = promise->get_future();
+
+    natsInbox* inbox = nullptr;
+    natsInbox_Create(&inbox);
+    auto* closure = new Promise(promise);
+    natsSubscription* sub = nullptr;
+    natsStatus s = natsConnection_SubscribeTimeout(&sub, conn, inbox, timeout.count(),
+        [](natsConnection*, natsSubscription* sub, natsMsg* msg, void* closure) {
+            std::unique_ptr<Promise> owner(static_cast<Promise*>(closure));
+            Response response;
+            if (msg && response.ParseFromArray(natsMsg_GetData(msg), natsMsg_GetDataLength(msg))) {
+                (*owner)->set_value(std::move(response));
+            } else {
+                (*owner)->set_exception(std::make_exception_ptr(std::runtime_error("request timed out")));
+            }
+            if (msg) {
+                natsMsg_Destroy(msg);
+            }
+            natsSubscription_Unsubscribe(sub);
+            natsSubscription_Destroy(sub);
+        }, closure);
+    if (s == NATS_OK) {
+        s = natsConnection_PublishRequest(conn, subject.c_str(), inbox, payload.data(),
+                                          static_cast<int>(payload.size()));
+    } else {
+        delete closure;
+    }
+    natsInbox_Destroy(inbox);
+    if (s != NATS_OK) {
+        promise->set_exception(std::make_exception_ptr(std::runtime_error(natsStatus_GetText(s))));
+    }
+    return reply;
+}
+
+struct Variant {
+    const char* name;
+    std::function<TaskFuture<Response>(int)> send;  // Request number -> reply
+};
+
+double percentile(std::vector<double>& samples, double p) {
+    const size_t index = std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+void run_latency(const Variant& variant, size_t requests) {
+    std::vector<double> micros;
+    micros.reserve(requests);
+    size_t failed = 0;
+    for (size_t i = 0; i < requests; ++i) {
+        const auto start = Clock::now();
+        TaskFuture<Response> reply = variant.send(static_cast<int>(i));
+        reply.wait();
+        micros.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        try {
+            reply.get();
+        } catch (const std::exception&) {
+            ++failed;
+        }
+    }
+    double total = 0;
+    for (double m : micros) {
+        total += m;
+    }
+    std::cout << std::left << std::setw(16) << variant.name << std::right
+              << std::setw(10) << total / micros.size()
+              << std::setw(10) << percentile(micros, 0.50)
+              << std::setw(10) << percentile(micros, 0.99)
+              << std::setw(10) << percentile(micros, 0.999)
+              << std::setw(8) << failed << "\n";
+}
+
+void run_concurrency(const Variant& variant, size_t requests, size_t window) {
+    std::vector<TaskFuture<Response>> in_flight;
+    in_flight.reserve(window);
+    size_t sent = 0;
+    size_t failed = 0;
+    const auto start = Clock::now();
+    while (sent < requests) {
+        in_flight.clear();
+        for (size_t i = 0; i < window && sent < requests; ++i, ++sent) {
+            in_flight.push_back(variant.send(static_cast<int>(sent)));
+        }
+        for (auto& reply : in_flight) {
+            reply.wait();
+            try {
+                reply.get();
+            } catch (const std::exception&) {
+                ++failed;
+            }
+        }
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << std::left << std::setw(16) << variant.name << std::right
+              << std::setw(8) << window
+              << std::setw(14) << static_cast<size_t>(requests / seconds)
+              << std::setw(8) << failed << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t requests = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const char* env_url = std::getenv("NATS_URL");
+    const std::string url = env_url ? env_url : "nats://localhost:4222";
+    Logger::set_level(Logger::Level::WARN);
+
+    natsConnection* conn = nullptr;
+    if (natsConnection_ConnectTo(&conn, url.c_str()) != NATS_OK) {
+        std::cerr << "No NATS server at " << url << "\n";
+        return 1;
+    }
+
+    ServiceHost responder("bench-responder-001", "RequestReplyResponder");
+    responder.StartService(bench_config(url));
+    responder.register_request_handler<Request, Response>(
+        MessageRouting::PointToPoint, [&responder](const Request& req) {
+            Response res;
+            res.set_service_name(req.service_name());
+            res.set_uid(responder.get_uid());
+            res.set_status("ok");
+            return res;
+        });
+
+    ServiceHost requester("bench-requester-001", "RequestReplyRequester");
+    requester.StartService(bench_config(url));
+
+    const std::chrono::milliseconds timeout(5000);
+    const std::string subject = "system.direct." + responder.get_uid() + "." + Request::descriptor()->full_name();
+    auto make_request = [](int i) {
+        Request req;
+        req.set_service_name("bench-" + std::to_string(i));
+        req.set_uid("bench-requester-001");
+        return req;
+    };
+
+    const std::vector<Variant> variants = {
+        {"shared inbox", [&](int i) {
+             return requester.request<Request, Response>(responder.get_uid(), make_request(i), timeout);
+         }},
+        {"per-call sub", [&](int i) {
+             return per_call_request(conn, requester.get_thread_pool(), subject,
+                                     make_request(i).SerializeAsString(), timeout);
+         }},
+    };
+
+    // Warm up connections, inbox and pools
+    for (const auto& variant : variants) {
+        for (int i = 0; i < 200; ++i) {
+            variant.send(i).wait();
+        }
+    }
+
+    std::cout << std::setfill(' ') << std::fixed << std::setprecision(1) << "\n🚀 ServiceHost Request/Reply Benchmark (" << requests << " requests)\n\n";
+    std::cout << "Round-trip latency, one request at a time (μs)\n";
+    std::cout << std::left << std::setw(16) << "variant" << std::right
+              << std::setw(10) << "mean" << std::setw(10) << "p50"
+              << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(8) << "failed" << "\n";
+    for (const auto& variant : variants) {
+        run_latency(variant, std::min<size_t>(requests, 10000));
+    }
+
+    std::cout << "\nThroughput with a window of requests in flight\n";
+    std::cout << std::left << std::setw(16) << "variant" << std::right
+              << std::setw(8) << "window" << std::setw(14) << "requests/s" << std::setw(8) << "failed" << "\n";
+    for (size_t window : {1, 16, 128, 1024}) {
+        for (const auto& variant : variants) {
+            run_concurrency(variant, requests, window);
+        }
+    }
+
+    requester.shutdown();
+    responder.shutdown();
+    natsConnection_Destroy(conn);
+    return 0;
+}
@@ -0,0 +1,136 @@
+// ThreadPool contention benchmark
+//
+// Compares the default SharedQueue pool (one std::queue + mutex + condvar)
+// against the WorkStealing pool (per-worker deques) at 1-64 worker threads.
+//
+// Two workloads:
+//   external - several producer threads submit tiny tasks, like NATS callbacks
+//              delivering a market-data burst
+//   nested   - tasks fan out child tasks from inside the pool, which is where
+//              local deques avoid the shared lock entirely
+//
+// Usage: thread_pool_contention_benchmark [tasks_per_run] [producers]
+
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Mode = ThreadPool::SchedulingMode;
+
+const char* mode_name(Mode mode) {
+    return mode == Mode::WorkStealing ? "work-stealing" : "shared-queue";
+}
+
+// Small amount of CPU work so the queue, not the task body, dominates
+inline void spin_work() {
+    volatile int x = 0;
+    for (int i = 0; i < 50; ++i) {
+        x = x + i;
+    }
+}
+
+void wait_for(const std::atomic<size_t>& counter, size_t target) {
+    while (counter.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+}
+
+double run_external(Mode mode, size_t threads, size_t total_tasks, size_t producers) {
+    ThreadPool pool(threads, mode);
+    std::atomic<size_t> completed{0};
+    const size_t per_producer = total_tasks / producers;
+
+    auto start = Clock::now();
+
+    std::vector<std::thread> submitters;
+    for (size_t p = 0; p < producers; ++p) {
+        submitters.emplace_back([&pool, &completed, per_producer]() {
+            for (size_t i = 0; i < per_producer; ++i) {
+                pool.submit([&completed]() {
+                    spin_work();
+                    completed.fetch_add(1, std::memory_order_release);
+                });
+            }
+        });
+    }
+    for (auto& t : submitters) {
+        t.join();
+    }
+    wait_for(completed, per_producer * producers);
+
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    return (per_producer * producers) / elapsed;
+}
+
+double run_nested(Mode mode, size_t threads, size_t total_tasks) {
+    ThreadPool pool(threads, mode);
+    std::atomic<size_t> completed{0};
+    const size_t fan_out = 100;
+    const size_t parents = total_tasks / fan_out;
+
+    auto start = Clock::now();
+
+    for (size_t p = 0; p < parents; ++p) {
+        pool.submit([&pool, &completed, fan_out]() {
+            for (size_t c = 0; c < fan_out; ++c) {
+                pool.submit([&completed]() {
+                    spin_work();
+                    completed.fetch_add(1, std::memory_order_release);
+                });
+            }
+        });
+    }
+    wait_for(completed, parents * fan_out);
+
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    return (parents * fan_out) / elapsed;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t total_tasks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const size_t producers = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4;
+    const std::vector<size_t> thread_counts = {1, 2, 4, 8, 16, 32, 64};
+
+    std::cout << "\n🚀 ThreadPool Contention Benchmark\n";
+    std::cout << "=====================================\n";
+    std::cout << "Tasks per run: " << total_tasks << ", producers: " << producers
+              << ", hardware threads: " << std::thread::hardware_concurrency() << "\n\n";
+
+    std::cout << std::left << std::setw(10) << "threads"
+              << std::setw(16) << "workload"
+              << std::right << std::setw(20) << "shared (tasks/s)"
+              << std::setw(20) << "stealing (tasks/s)"
+              << std::setw(10) << "speedup" << "\n";
+
+    for (size_t threads : thread_counts) {
+        double shared = run_external(Mode::SharedQueue, threads, total_tasks, producers);
+        double stealing = run_external(Mode::WorkStealing, threads, total_tasks, producers);
+        std::cout << std::left << std::setw(10) << threads << std::setw(16) << "external"
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(20) << shared << std::setw(20) << stealing
+                  << std::setprecision(2) << std::setw(9) << stealing / shared << "x\n";
+
+        shared = run_nested(Mode::SharedQueue, threads, total_tasks);
+        stealing = run_nested(Mode::WorkStealing, threads, total_tasks);
+        std::cout << std::left << std::setw(10) << threads << std::setw(16) << "nested"
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(20) << shared << std::setw(20) << stealing
+                  << std::setprecision(2) << std::setw(9) << stealing / shared << "x\n";
+    }
+
+    std::cout << "=====================================\n";
+    std::cout << "Modes: " << mode_name(Mode::SharedQueue) << " vs " << mode_name(Mode::WorkStealing) << "\n\n";
+    return 0;
+}
@@ -90,7 +90,25 @@ private:
 
     void loadDefaults() {
         data_["nats.url"] = "nats://localhost:4222";
+        data_["nats.queue_group"] = "";                   // QueueGroup routing; empty = service name
         data_["threads"]  = "4";
+        data_["threads.queue_backend"] = "shared";        // shared | work_stealing | ring
+        data_["threads.ring_capacity"] = "8192";          // ring: slots per lane when unbounded
+        data_["threads.lane_policy"] = "strict";          // strict | weighted
+        data_["threads.high_priority_weight"] = "8";      // weighted: High tasks per Normal task
+        data_["threads.cpu_list"] = "";                   // e.g. "0-7,16-23"; empty = no pinning
+        data_["threads.numa_layout"] = "none";            // none | per_node
+        data_["threads.queue_capacity"] = "0";            // Max queued Normal tasks; 0 = unbounded
+        data_["threads.deadlines"] = "true";              // Honour message deadlines (drop expired work)
+        data_["threads.overflow_policy"] = "block";       // block | reject | drop_oldest | drop_newest_by_key
+        data_["threads.elastic"] = "false";               // Resize between min and max on queue wait
+        data_["threads.min"] = "1";
+        data_["threads.max"] = "0";                       // 0 = "threads"
+        data_["threads.grow_wait_us"] = "2000";           // Add a worker above this queue wait
+        data_["threads.shrink_wait_us"] = "200";          // Retire idle workers below it
+        data_["threads.idle_spin_us"] = "0";              // Spin before parking an idle worker
+        data_["threads.idle_yield_us"] = "0";             // Then yield for this long
+        data_["threads.task_timings"] = "true";           // Queue-wait / run-time histograms
     }
 
     void loadYaml() {
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "inline_task.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * @brief Latest-value-per-key executor on top of ThreadPool
+ *
+ * Like KeyedExecutor, tasks under one key run one at a time and different
+ * keys run in parallel, but each key holds at most ONE pending task: a
+ * submit() for a key that already has a task waiting replaces it in place
+ * and the replaced task is dropped unrun (counted by conflated()). Used for
+ * market data, where a newer price for a symbol makes a queued older one
+ * worthless; under load a slow handler skips straight to the latest
+ * update, in normal operation nothing is dropped.
+ *
+ * A key's slot lives while its drain job is scheduled or running; the
+ * drain runs the pending task, picks up whatever replaced it meanwhile,
+ * and erases the slot once nothing is pending. After kDrainBurst tasks it
+ * resubmits itself so one hot key cannot monopolize a worker. Keys are
+ * spread over kShards independently locked maps; no lock is held while a
+ * task runs. State is shared with in-flight drain jobs, so the inbox may be
+ * destroyed before the pool; after the pool shuts down, a drain that
+ * cannot resubmit finishes inline.
+ *
+ * If a bounded pool refuses a drain, submit() returns false (counted by
+ * refused()) but the update is kept, not dropped: it stays pending and
+ * the key is parked. Parked keys are retried whenever one of this inbox's
+ * drains finishes and on the next submit() for any key, so the last price
+ * of a symbol that goes quiet still runs once other symbols keep flowing;
+ * a newer update for the key meanwhile conflates over it as usual.
+ */
+class ConflatingInbox {
+public:
+    static constexpr size_t kShards = 64;
+    static constexpr size_t kDrainBurst = 16;
+
+    explicit ConflatingInbox(ThreadPool& pool)
+        : state_(std::make_shared<State>(pool)) {}
+
+    ConflatingInbox(const ConflatingInbox&) = delete;
+    ConflatingInbox& operator=(const ConflatingInbox&) = delete;
+
+    // Make 'task' the pending task for 'key', replacing any task still
+    // waiting there. 'priority' is the pool lane used for the key's drain.
+    // Returns false if the pool has already shut down, or if it refused the
+    // drain; a refused task stays pending and its key is retried later.
+    template <typename F>
+    bool submit(const std::string& key, F&& task,
+                TaskPriority priority = TaskPriority::Normal) {
+        if (state_->pool.is_shutdown()) {
+            return false;
+        }
+        if (state_->parked_count.load(std::memory_order_relaxed) > 0) {
+            retry_parked(state_);
+        }
+        InlineTask wrapped(std::forward<F>(task));
+        InlineTask replaced;  // Destroyed after the lock is released
+        Shard& shard = state_->shard_for(key);
+        {
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            Slot& slot = shard.slots.try_emplace(key).first->second;
+            if (slot.pending) {
+                replaced = std::move(slot.pending);
+                state_->conflated.fetch_add(1, std::memory_order_relaxed);
+            }
+            slot.pending = std::move(wrapped);
+            if (slot.scheduled) {
+                return true;  // Drain already scheduled or running for this key
+            }
+            slot.scheduled = true;
+            slot.priority = priority;
+        }
+        if (schedule_drain(state_, key, priority)) {
+            return true;
+        }
+        if (state_->pool.is_shutdown()) {
+            drain(state_, key);  // Shut down after the check above; run what was accepted
+            return true;
+        }
+        state_->refused.fetch_add(1, std::memory_order_relaxed);
+        park(state_, key);
+        return false;
+    }
+
+    // Tasks replaced by a newer one for the same key before they ran
+    size_t conflated() const { return state_->conflated.load(std::memory_order_relaxed); }
+
+    // Submissions whose drain the pool refused; their task was left pending
+    size_t refused() const { return state_->refused.load(std::memory_order_relaxed); }
+
+    // Number of keys that currently have a pending or running task
+    size_t active_keys() const {
+        size_t total = 0;
+        for (auto& shard : state_->shards) {
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            total += shard.slots.size();
+        }
+        return total;
+    }
+
+private:
+    struct Slot {
+        InlineTask pending;  // Empty while the latest task runs
+        TaskPriority priority = TaskPriority::Normal;
+        bool scheduled = false;  // A drain job is queued or running
+    };
+
+    struct Shard {
+        mutable std::mutex mtx;
+        std::unordered_map<std::string, Slot> slots;
+    };
+
+    struct State {
+        explicit State(ThreadPool& p) : pool(p) {}
+
+        Shard& shard_for(const std::string& key) {
+            return shards[std::hash<std::string>{}(key) % kShards];
+        }
+
+        ThreadPool& pool;
+        std::array<Shard, kShards> shards;
+        std::atomic<size_t> conflated{0};
+        std::atomic<size_t> refused{0};
+
+        // Keys holding a pending task but no drain after a refusal
+        std::mutex parked_mtx;
+        std::vector<std::string> parked;
+        std::atomic<size_t> parked_count{0};
+    };
+
+    // Mark 'key' idle after its drain was refused and queue it for a retry
+    static void park(const std::shared_ptr<State>& state, const std::string& key) {
+        {
+            Shard& shard = state->shard_for(key);
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            shard.slots.find(key)->second.scheduled = false;
+        }
+        std::lock_guard<std::mutex> lk(state->parked_mtx);
+        state->parked.push_back(key);
+        state->parked_count.store(state->parked.size(), std::memory_order_relaxed);
+    }
+
+    // Schedule drains for parked keys that are still pending without one;
+    // a key refused again is parked for the next attempt
+    static void retry_parked(const std::shared_ptr<State>& state) {
+        std::vector<std::string> keys;
+        {
+            std::lock_guard<std::mutex> lk(state->parked_mtx);
+            keys.swap(state->parked);
+            state->parked_count.store(0, std::memory_order_relaxed);
+        }
+        for (const auto& key : keys) {
+            Shard& shard = state->shard_for(key);
+            TaskPriority priority;
+            {
+                std::lock_guard<std::mutex> lk(shard.mtx);
+                auto it = shard.slots.find(key);
+                if (it == shard.slots.end() || it->second.scheduled) {
+                    continue;  // Rescheduled by a submit meanwhile
+                }
+                it->second.scheduled = true;
+                priority = it->second.priority;
+            }
+            if (schedule_drain(state, key, priority)) {
+                continue;
+            }
+            if (state->pool.is_shutdown()) {
+                drain(state, key);
+                continue;
+            }
+            park(state, key);
+        }
+    }
+
+    static bool schedule_drain(const std::shared_ptr<State>& state,
+                               const std::string& key, TaskPriority priority) {
+        return state->pool.submit([state, key]() { drain(state, key); }, priority);
+    }
+
+    static void drain(const std::shared_ptr<State>& state, const std::string& key) {
+        Shard& shard = state->shard_for(key);
+        for (size_t ran = 0;; ++ran) {
+            InlineTask task;
+            {
+                std::lock_guard<std::mutex> lk(shard.mtx);
+                auto it = shard.slots.find(key);
+                if (!it->second.pending) {
+                    shard.slots.erase(it);
+                    break;
+                }
+                if (ran == kDrainBurst) {
+                    // Yield the worker; the key stays marked busy until the resubmitted drain
+                    if (schedule_drain(state, key, it->second.priority)) {
+                        return;
+                    }
+                    ran = 0;  // Pool shut down or full: keep draining on this worker
+                }
+                task = std::move(it->second.pending);
+            }
+            try {
+                task();
+            } catch (...) {
+                // Same policy as ThreadPool: a failing task must not stall its key
+            }
+        }
+        // The pool just had room for this drain; give parked keys their turn
+        if (state->parked_count.load(std::memory_order_relaxed) > 0) {
+            retry_parked(state);
+        }
+    }
+
+    std::shared_ptr<State> state_;
+};
@@ -0,0 +1,241 @@
+#pragma once
+
+// C++20 coroutines on top of ThreadPool, TaskFuture and ServiceScheduler.
+// Everything below is compiled only when the compiler has coroutines
+// (ENABLE_COROUTINES builds the tree as C++20); SERVICE_COROUTINES tells
+// other headers whether it is available.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define SERVICE_COROUTINES 1
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "service_scheduler.hpp"
+#include "task_future.hpp"
+#include "thread_pool.hpp"
+
+template <typename T = void>
+class CoTask;
+
+namespace coroutine_detail {
+
+// Result slot shared by CoTask<T> promises
+template <typename T>
+struct PromiseResult {
+    std::optional<T> value;
+    std::exception_ptr error;
+
+    template <typename U>
+    void return_value(U&& result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T result() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct PromiseResult<void> {
+    std::exception_ptr error;
+
+    void return_void() noexcept {}
+
+    void result() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+// Fire-and-forget coroutine: starts at once, frees its frame when done
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }  // drive() catches everything
+    };
+};
+
+template <typename T>
+Detached drive(ThreadPool* pool, CoTask<T> task, TaskPromise<T> promise);
+
+}  // namespace coroutine_detail
+
+/**
+ * @brief Lazily started coroutine returning T
+ *
+ * A CoTask does nothing until it is co_awaited (the awaiting coroutine is
+ * resumed when it finishes, with its value or exception) or handed to
+ * co_spawn()/co_detach(). It runs on whichever thread resumed it last; use
+ * the awaitables below to move onto the pool, sleep, or wait for a
+ * TaskFuture without blocking a worker:
+ *
+ *   co_await schedule_on(pool);                  // hop onto a pool worker
+ *   co_await resume_after(scheduler, 50ms);      // timer, resumes on the pool
+ *   std::string reply = co_await host.request_async(subject, payload, 2s);
+ *
+ * Move-only; destroying an unfinished CoTask destroys its frame.
+ */
+template <typename T>
+class CoTask {
+public:
+    struct promise_type : coroutine_detail::PromiseResult<T> {
+        std::coroutine_handle<> continuation;
+
+        CoTask get_return_object() noexcept {
+            return CoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept { return FinalAwaiter{}; }
+        void unhandled_exception() noexcept { this->error = std::current_exception(); }
+    };
+
+    CoTask(CoTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    CoTask& operator=(CoTask&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    ~CoTask() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    // Awaiting starts the task; the awaiter resumes by symmetric transfer
+    bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle_.promise().continuation = awaiting;
+        return handle_;
+    }
+
+    T await_resume() { return handle_.promise().result(); }
+
+private:
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> done) noexcept {
+            auto continuation = done.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    explicit CoTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Awaitable: continue on a worker of 'pool'. If the pool refuses the task
+// (shut down, or full under Reject) the coroutine continues inline.
+struct PoolAwaiter {
+    ThreadPool& pool;
+    TaskPriority priority;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> handle) {
+        return pool.submit([handle]() { handle.resume(); }, priority);
+    }
+    void await_resume() const noexcept {}
+};
+
+inline PoolAwaiter schedule_on(ThreadPool& pool, TaskPriority priority = TaskPriority::Normal) {
+    return PoolAwaiter{pool, priority};
+}
+
+// Awaitable: continue on the scheduler's pool once 'delay' has passed.
+// A stopped scheduler continues the coroutine at once; one that stops
+// before the timer fires resumes it from stop() (on the pool, or inline if
+// the pool refuses), so a suspended frame is never stranded.
+struct TimerAwaiter {
+    ServiceScheduler& scheduler;
+    std::chrono::milliseconds delay;
+    TaskPriority priority;
+
+    bool await_ready() const noexcept { return delay.count() <= 0 || !scheduler.is_running(); }
+    void await_suspend(std::coroutine_handle<> handle) {
+        auto config = ServiceScheduler::TaskConfig::create_default();
+        config.priority = priority;
+        config.run_on_stop = true;
+        // May resume the coroutine before returning; touch no members after
+        scheduler.schedule_once("coroutine.resume_after", delay, [handle]() { handle.resume(); }, config);
+    }
+    void await_resume() const noexcept {}
+};
+
+inline TimerAwaiter resume_after(ServiceScheduler& scheduler, std::chrono::milliseconds delay,
+                                 TaskPriority priority = TaskPriority::Normal) {
+    return TimerAwaiter{scheduler, delay, priority};
+}
+
+// Awaitable: a TaskFuture's value (or exception). The coroutine resumes on
+// the future's pool, never on the thread that completed it.
+template <typename T>
+struct FutureAwaiter {
+    TaskFuture<T> future;
+
+    bool await_ready() const { return future.is_ready(); }
+    void await_suspend(std::coroutine_handle<> handle) const {
+        future.on_ready([handle]() { handle.resume(); });
+    }
+    std::conditional_t<std::is_void_v<T>, void, T> await_resume() const { return future.get(); }
+};
+
+template <typename T>
+FutureAwaiter<T> operator co_await(TaskFuture<T> future) {
+    return FutureAwaiter<T>{std::move(future)};
+}
+
+// Start 'task' on a pool worker; the future completes with its result
+template <typename T>
+TaskFuture<T> co_spawn(ThreadPool& pool, CoTask<T> task) {
+    TaskPromise<T> promise(&pool);
+    TaskFuture<T> future = promise.get_future();
+    coroutine_detail::drive(&pool, std::move(task), std::move(promise));
+    return future;
+}
+
+// Run 'task' on the calling thread up to its first suspension and let it
+// finish wherever it is resumed. Its result and exceptions are discarded,
+// so catch inside the task.
+inline void co_detach(CoTask<void> task) {
+    coroutine_detail::drive(nullptr, std::move(task), TaskPromise<void>());
+}
+
+template <typename T>
+coroutine_detail::Detached coroutine_detail::drive(ThreadPool* pool, CoTask<T> task,
+                                                   TaskPromise<T> promise) {
+    if (pool) {
+        co_await schedule_on(*pool);
+    }
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await task;
+            promise.set_value();
+        } else {
+            promise.set_value(co_await task);
+        }
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+#endif  // coroutines available
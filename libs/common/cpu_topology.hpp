@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+
+/**
+ * @brief CPU list parsing, NUMA node discovery and thread pinning (Linux)
+ *
+ * Topology comes from sysfs (/sys/devices/system/node/nodeN/cpulist), so no
+ * libnuma dependency is needed. On machines without that directory the
+ * whole box is reported as a single node.
+ */
+namespace CpuTopology {
+
+// Parse a Linux-style CPU list such as "0-3,8,10-11". Invalid entries are
+// skipped; the result is sorted and free of duplicates.
+inline std::vector<int> parse_cpu_list(const std::string& list)
+{
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item.erase(std::remove_if(item.begin(), item.end(), ::isspace), item.end());
+        if (item.empty()) {
+            continue;
+        }
+        char* end = nullptr;
+        long first = std::strtol(item.c_str(), &end, 10);
+        if (end == item.c_str() || first < 0) {
+            continue;
+        }
+        long last = first;
+        if (*end == '-') {
+            const char* range_end = end + 1;
+            last = std::strtol(range_end, &end, 10);
+            if (end == range_end || last < first) {
+                continue;
+            }
+        }
+        if (*end != '\0') {
+            continue;
+        }
+        for (long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+// CPUs per NUMA node, indexed by node id order. Never empty.
+inline std::vector<std::vector<int>> numa_nodes()
+{
+    std::vector<std::pair<int, std::vector<int>>> found;
+    if (DIR* dir = opendir("/sys/devices/system/node")) {
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+                !std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+                continue;
+            }
+            std::ifstream in("/sys/devices/system/node/" + name + "/cpulist");
+            std::string list;
+            std::getline(in, list);
+            auto cpus = parse_cpu_list(list);
+            if (!cpus.empty()) {
+                found.emplace_back(std::stoi(name.substr(4)), std::move(cpus));
+            }
+        }
+        closedir(dir);
+    }
+
+    std::sort(found.begin(), found.end());
+    std::vector<std::vector<int>> nodes;
+    for (auto& node : found) {
+        nodes.push_back(std::move(node.second));
+    }
+    if (nodes.empty()) {
+        std::vector<int> all;
+        unsigned n = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < n; ++cpu) {
+            all.push_back(static_cast<int>(cpu));
+        }
+        nodes.push_back(std::move(all));
+    }
+    return nodes;
+}
+
+// Restrict the calling thread to 'cpus'. Returns false if the kernel
+// rejected the mask (e.g. CPUs outside the cgroup's cpuset).
+inline bool pin_current_thread(const std::vector<int>& cpus)
+{
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// CPU the calling thread is running on right now, or -1 if unknown
+inline int current_cpu()
+{
+    return sched_getcpu();
+}
+
+} // namespace CpuTopology
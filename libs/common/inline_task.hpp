@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Move-only `void()` callable with an inline small buffer
+ *
+ * Replacement for std::function<void()> on the ThreadPool hot path.
+ * Callables up to kInlineCapacity bytes are constructed in place, so the
+ * common submission (handler + parsed message + logger + a few strings)
+ * never touches the heap. Larger or throwing-move callables spill to a
+ * single heap allocation; is_inline() reports which path was taken.
+ *
+ * Unlike std::function, move-only captures (unique_ptr, promise) are allowed.
+ */
+class InlineTask {
+public:
+    // Sized for the register_message()/receive_message() closures: a
+    // std::function handler, a parsed protobuf message, a shared_ptr<Logger>,
+    // two std::strings and a time_point fit with room to spare.
+    static constexpr size_t kInlineCapacity = 192;
+
+    InlineTask() noexcept = default;
+
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineTask>>>
+    InlineTask(F&& f) {
+        using Fn = std::decay_t<F>;
+        if constexpr (fits_inline<Fn>()) {
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+            ops_ = &inline_ops<Fn>;
+        } else {
+            ::new (static_cast<void*>(storage_)) Fn*(new Fn(std::forward<F>(f)));
+            ops_ = &heap_ops<Fn>;
+        }
+    }
+
+    InlineTask(InlineTask&& other) noexcept {
+        move_from(other);
+    }
+
+    InlineTask& operator=(InlineTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    InlineTask(const InlineTask&) = delete;
+    InlineTask& operator=(const InlineTask&) = delete;
+
+    ~InlineTask() {
+        reset();
+    }
+
+    void operator()() {
+        ops_->invoke(storage_);
+    }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    // False when the callable was too large for the inline buffer
+    bool is_inline() const noexcept { return ops_ == nullptr || !ops_->on_heap; }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept;  // Move-construct dst, destroy src
+        void (*destroy)(void* storage) noexcept;
+        bool on_heap;
+    };
+
+    template <typename Fn>
+    static constexpr bool fits_inline() {
+        return sizeof(Fn) <= kInlineCapacity &&
+               alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <typename Fn>
+    static inline constexpr Ops inline_ops = {
+        [](void* s) { (*static_cast<Fn*>(s))(); },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+            static_cast<Fn*>(src)->~Fn();
+        },
+        [](void* s) noexcept { static_cast<Fn*>(s)->~Fn(); },
+        false
+    };
+
+    template <typename Fn>
+    static inline constexpr Ops heap_ops = {
+        [](void* s) { (**static_cast<Fn**>(s))(); },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) Fn*(*static_cast<Fn**>(src));
+        },
+        [](void* s) noexcept { delete *static_cast<Fn**>(s); },
+        true
+    };
+
+    void move_from(InlineTask& other) noexcept {
+        if (other.ops_) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[kInlineCapacity];
+    const Ops* ops_ = nullptr;
+};
@@ -0,0 +1,163 @@
+#include "jetstream_consumer.hpp"
+#include "logger.hpp"
+#include <algorithm>
+
+namespace {
+
+size_t default_window(const ThreadPool &pool, const JetStreamConsumer::Options &options) {
+    if (options.max_in_flight > 0) {
+        return options.max_in_flight;
+    }
+    if (pool.capacity() > 0) {
+        return pool.capacity();
+    }
+    return 2 * std::max<size_t>(options.fetch_batch, 1);
+}
+
+} // namespace
+
+JetStreamConsumer::JetStreamConsumer(jsCtx *js, ThreadPool &pool, Options options, Handler handler,
+                                     std::shared_ptr<Logger> logger, TaskPriority priority)
+    : js_(js),
+      pool_(pool),
+      options_(std::move(options)),
+      handler_(std::move(handler)),
+      logger_(std::move(logger)),
+      priority_(priority),
+      window_(default_window(pool, options_)) {}
+
+JetStreamConsumer::~JetStreamConsumer() {
+    stop();
+}
+
+bool JetStreamConsumer::start() {
+    if (!js_) {
+        logger_->error("❌ Cannot start JetStream consumer {}: JetStream not initialized", options_.durable);
+        return false;
+    }
+
+    jsSubOptions so;
+    jsSubOptions_Init(&so);
+    if (!options_.stream.empty()) {
+        so.Stream = options_.stream.c_str();
+    }
+    so.Config.AckPolicy = js_AckExplicit;
+    so.Config.MaxAckPending = static_cast<int64_t>(window_);
+    if (options_.ack_wait.count() > 0) {
+        so.Config.AckWait = std::chrono::duration_cast<std::chrono::nanoseconds>(options_.ack_wait).count();
+    }
+
+    jsErrCode jerr = static_cast<jsErrCode>(0);
+    natsStatus s = js_PullSubscribe(&sub_, js_, options_.subject.c_str(), options_.durable.c_str(),
+                                    nullptr, &so, &jerr);
+    if (s != NATS_OK) {
+        logger_->error("❌ Failed to create JetStream pull consumer {} on {}: {} (js error {})",
+                       options_.durable, options_.subject, natsStatus_GetText(s), static_cast<int>(jerr));
+        sub_ = nullptr;
+        return false;
+    }
+
+    fetcher_ = std::thread([this]() { fetch_loop(); });
+    logger_->info("✅ JetStream pull consumer {} on {} (batch {}, max in flight {})",
+                  options_.durable, options_.subject, options_.fetch_batch, window_);
+    return true;
+}
+
+void JetStreamConsumer::stop() {
+    if (stopping_.exchange(true)) {
+        return;
+    }
+    room_.notify_all();
+    if (fetcher_.joinable()) {
+        fetcher_.join();  // At most one fetch_timeout
+    }
+
+    // Messages already submitted are acked (or naked) by their jobs
+    {
+        std::unique_lock<std::mutex> lk(mtx_);
+        room_.wait(lk, [this]() { return in_flight_.load() == 0; });
+    }
+
+    if (sub_) {
+        // Destroy, not Unsubscribe: that would delete the durable consumer
+        natsSubscription_Destroy(sub_);
+        sub_ = nullptr;
+    }
+}
+
+size_t JetStreamConsumer::wait_for_room() {
+    std::unique_lock<std::mutex> lk(mtx_);
+    for (;;) {
+        if (stopping_.load()) {
+            return 0;
+        }
+        size_t room = window_ - std::min(window_, in_flight_.load());
+        if (pool_.capacity() > 0) {
+            const size_t pending = pool_.pending_tasks();
+            room = std::min(room, pool_.capacity() - std::min(pool_.capacity(), pending));
+        }
+        if (room > 0) {
+            return std::min(room, std::max<size_t>(options_.fetch_batch, 1));
+        }
+        // Woken by an ack; the timeout re-checks a queue drained by other work
+        room_.wait_for(lk, options_.fetch_timeout);
+    }
+}
+
+void JetStreamConsumer::fetch_loop() {
+    const int64_t timeout_ms = std::max<int64_t>(options_.fetch_timeout.count(), 1);
+    while (size_t want = wait_for_room()) {
+        natsMsgList list{nullptr, 0};
+        jsErrCode jerr = static_cast<jsErrCode>(0);
+        natsStatus s = natsSubscription_Fetch(&list, sub_, static_cast<int>(want), timeout_ms, &jerr);
+        if (s == NATS_TIMEOUT) {
+            continue;  // Stream idle
+        }
+        if (s != NATS_OK) {
+            logger_->warn("JetStream fetch failed for {}: {} (js error {})",
+                          options_.durable, natsStatus_GetText(s), static_cast<int>(jerr));
+            std::unique_lock<std::mutex> lk(mtx_);
+            room_.wait_for(lk, options_.fetch_timeout, [this]() { return stopping_.load(); });
+            continue;
+        }
+
+        for (int i = 0; i < list.Count; ++i) {
+            natsMsg *msg = list.Msgs[i];
+            list.Msgs[i] = nullptr;  // Owned by its job from here on
+            in_flight_.fetch_add(1);
+            fetched_.fetch_add(1, std::memory_order_relaxed);
+
+            MessageBuffer payload = MessageBuffer::adopt(msg);
+            if (!pool_.submit([this, msg, payload]() { process(msg, payload); }, priority_)) {
+                finish(msg, false);  // Pool shutting down: redeliver later
+            }
+        }
+        natsMsgList_Destroy(&list);
+    }
+}
+
+void JetStreamConsumer::process(natsMsg *msg, const MessageBuffer &payload) {
+    bool ok = false;
+    try {
+        ok = handler_(payload);
+    } catch (const std::exception &e) {
+        logger_->error("JetStream handler failed for {}: {}", options_.durable, e.what());
+    } catch (...) {
+        logger_->error("JetStream handler failed for {} with unknown exception", options_.durable);
+    }
+    finish(msg, ok);
+}
+
+void JetStreamConsumer::finish(natsMsg *msg, bool ok) {
+    natsStatus s = ok ? natsMsg_Ack(msg, nullptr) : natsMsg_Nak(msg, nullptr);
+    if (s != NATS_OK) {
+        logger_->warn("JetStream {} failed for {}: {}", ok ? "ack" : "nak", options_.durable,
+                      natsStatus_GetText(s));
+    }
+    (ok ? acked_ : nacked_).fetch_add(1, std::memory_order_relaxed);
+
+    // Notify under the lock so stop() cannot miss the last decrement
+    std::lock_guard<std::mutex> lk(mtx_);
+    in_flight_.fetch_sub(1);
+    room_.notify_all();
+}
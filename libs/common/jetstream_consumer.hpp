@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <nats/nats.h>
+
+#include "message_buffer.hpp"
+#include "thread_pool.hpp"
+
+// Forward declarations
+class Logger;
+
+/**
+ * @brief Durable JetStream pull consumer feeding a ThreadPool
+ *
+ * One fetch thread pulls messages from a durable consumer in batches of up
+ * to fetch_batch and submits one pool job per message. The job runs the
+ * handler and acks the message after it returns true, or naks it for
+ * redelivery after it returns false. A message is therefore only acked
+ * once it has been processed, and an unacked message survives a crash.
+ *
+ * Flow control: at most max_in_flight() messages are fetched and not yet
+ * acked; the fetch thread asks for no more than the free part of that
+ * window and waits while it is full. The window defaults to the pool's
+ * queue capacity (or two batches for an unbounded pool), never exceeds the
+ * room left in a bounded queue, and is also set as the consumer's
+ * MaxAckPending so the server stops delivering at the same point. Pulling
+ * only what can be processed replaces core NATS push delivery, which drops
+ * messages once a slow consumer's buffer fills.
+ *
+ * stop() ends fetching and waits for in-flight messages to be acked; the
+ * durable consumer itself is left on the server so a restart resumes
+ * where this one stopped.
+ */
+class JetStreamConsumer {
+public:
+    struct Options {
+        std::string subject;                           // Stream subject (filter) to consume
+        std::string durable;                           // Durable consumer name
+        std::string stream;                            // Stream to bind to; empty = look up by subject
+        size_t fetch_batch = 64;                       // Messages per fetch request
+        std::chrono::milliseconds fetch_timeout{500};  // Fetch wait when the stream is idle
+        size_t max_in_flight = 0;                      // 0 = derived from the pool (see above)
+        std::chrono::milliseconds ack_wait{0};         // Redelivery timeout; 0 = server default
+    };
+
+    // Process one message; true acks it, false naks it for redelivery
+    using Handler = std::function<bool(const MessageBuffer &payload)>;
+
+    JetStreamConsumer(jsCtx *js, ThreadPool &pool, Options options, Handler handler,
+                      std::shared_ptr<Logger> logger, TaskPriority priority = TaskPriority::Normal);
+    ~JetStreamConsumer();
+
+    JetStreamConsumer(const JetStreamConsumer &) = delete;
+    JetStreamConsumer &operator=(const JetStreamConsumer &) = delete;
+
+    // Create or bind the durable pull subscription and start fetching.
+    // Returns false (and logs) if the subscription cannot be created.
+    bool start();
+
+    // Stop fetching, wait for in-flight messages and release the subscription
+    void stop();
+
+    const Options &options() const { return options_; }
+    size_t max_in_flight() const { return window_; }
+    size_t in_flight() const { return in_flight_.load(std::memory_order_relaxed); }
+    size_t fetched() const { return fetched_.load(std::memory_order_relaxed); }
+    size_t acked() const { return acked_.load(std::memory_order_relaxed); }
+    size_t nacked() const { return nacked_.load(std::memory_order_relaxed); }
+
+private:
+    void fetch_loop();
+    // Wait until part of the window is free; 0 when stopping
+    size_t wait_for_room();
+    void process(natsMsg *msg, const MessageBuffer &payload);
+    void finish(natsMsg *msg, bool ok);
+
+    jsCtx *js_;
+    ThreadPool &pool_;
+    const Options options_;
+    const Handler handler_;
+    std::shared_ptr<Logger> logger_;
+    const TaskPriority priority_;
+    const size_t window_;
+
+    natsSubscription *sub_ = nullptr;
+    std::thread fetcher_;
+    std::atomic<bool> stopping_{false};
+
+    std::mutex mtx_;
+    std::condition_variable room_;  // Signalled when in_flight_ drops
+    std::atomic<size_t> in_flight_{0};
+    std::atomic<size_t> fetched_{0};
+    std::atomic<size_t> acked_{0};
+    std::atomic<size_t> nacked_{0};
+};
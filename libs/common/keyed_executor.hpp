@@ -0,0 +1,244 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "inline_task.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * @brief Keyed serial executor (strands) on top of ThreadPool
+ *
+ * Tasks submitted under the same key run one at a time, in submission
+ * order; tasks under different keys run in parallel on the pool. Used for
+ * per-account ordering of PortfolioRequest/TradeRequest handlers without
+ * serializing whole handlers behind a mutex.
+ *
+ * Each active key owns a FIFO. The first task for an idle key schedules a
+ * single drain job on the pool; the drain runs up to kDrainBurst tasks and
+ * then resubmits itself so one hot key cannot monopolize a worker. A key's
+ * FIFO is erased once drained, so memory follows the number of keys with
+ * work in flight, not the number of keys ever seen. Keys are spread over
+ * kShards independently locked maps; no lock is held while a task runs.
+ *
+ * A bounded pool may refuse a drain (OverflowPolicy::Reject and the like).
+ * submit() then withdraws only its own task, counts it in rejected() and
+ * returns false. Tasks other threads queued behind it meanwhile were
+ * already accepted: they stay queued, the key is parked, and parked keys
+ * are retried whenever one of this executor's drains finishes and on the
+ * next submit() for any key.
+ *
+ * State is shared with in-flight drain jobs, so the executor may be
+ * destroyed before the pool. After the pool shuts down, a drain that cannot
+ * resubmit finishes its key's remaining tasks inline.
+ */
+class KeyedExecutor {
+public:
+    static constexpr size_t kShards = 64;
+    static constexpr size_t kDrainBurst = 16;
+
+    explicit KeyedExecutor(ThreadPool& pool)
+        : state_(std::make_shared<State>(pool)) {}
+
+    KeyedExecutor(const KeyedExecutor&) = delete;
+    KeyedExecutor& operator=(const KeyedExecutor&) = delete;
+
+    // Queue 'task' behind earlier tasks with the same key. 'priority' is the
+    // pool lane used while the key has work queued. Returns false, without
+    // queueing 'task', if the pool has already shut down or refused the
+    // key's drain.
+    template <typename F>
+    bool submit(const std::string& key, F&& task,
+                TaskPriority priority = TaskPriority::Normal) {
+        if (state_->pool.is_shutdown()) {
+            return false;
+        }
+        if (state_->parked_count.load(std::memory_order_relaxed) > 0) {
+            retry_parked(state_);
+        }
+        InlineTask wrapped(std::forward<F>(task));
+        Shard& shard = state_->shard_for(key);
+        size_t position;
+        {
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            Strand& strand = shard.strands.try_emplace(key).first->second;
+            position = strand.tasks.size();
+            strand.tasks.push_back(std::move(wrapped));
+            if (strand.scheduled) {
+                return true;  // Drain already scheduled or running for this key
+            }
+            strand.scheduled = true;
+            strand.priority = priority;
+        }
+        if (schedule_drain(state_, key, priority)) {
+            return true;
+        }
+        if (state_->pool.is_shutdown()) {
+            // Shut down after the check above; tasks already queued behind
+            // this key were accepted, so run them here
+            drain(state_, key);
+            return true;
+        }
+        withdraw(key, position);
+        return false;
+    }
+
+    // Tasks refused because the pool would not take their key's drain
+    size_t rejected() const { return state_->rejected.load(std::memory_order_relaxed); }
+
+    // Number of keys that currently have queued or running tasks
+    size_t active_keys() const {
+        size_t total = 0;
+        for (auto& shard : state_->shards) {
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            total += shard.strands.size();
+        }
+        return total;
+    }
+
+private:
+    struct Strand {
+        std::deque<InlineTask> tasks;  // Front is running or next to run
+        TaskPriority priority = TaskPriority::Normal;
+        bool scheduled = false;  // A drain job is queued or running
+    };
+
+    struct Shard {
+        mutable std::mutex mtx;
+        std::unordered_map<std::string, Strand> strands;
+    };
+
+    struct State {
+        explicit State(ThreadPool& p) : pool(p) {}
+
+        Shard& shard_for(const std::string& key) {
+            return shards[std::hash<std::string>{}(key) % kShards];
+        }
+
+        ThreadPool& pool;
+        std::array<Shard, kShards> shards;
+        std::atomic<size_t> rejected{0};
+
+        // Keys holding accepted tasks but no drain after a refusal
+        std::mutex parked_mtx;
+        std::vector<std::string> parked;
+        std::atomic<size_t> parked_count{0};
+    };
+
+    // The pool refused the drain this caller was scheduling. Nothing pops
+    // from a strand marked scheduled without a drain, so the caller's task
+    // is still at 'position'; tasks behind it were accepted by other
+    // submitters and are kept for a retry.
+    void withdraw(const std::string& key, size_t position) {
+        Shard& shard = state_->shard_for(key);
+        InlineTask dropped;  // Destroyed after the lock is released
+        {
+            std::lock_guard<std::mutex> lk(shard.mtx);
+            auto it = shard.strands.find(key);
+            Strand& strand = it->second;
+            dropped = std::move(strand.tasks[position]);
+            strand.tasks.erase(strand.tasks.begin() + position);
+            state_->rejected.fetch_add(1, std::memory_order_relaxed);
+            if (strand.tasks.empty()) {
+                shard.strands.erase(it);
+                return;
+            }
+            strand.scheduled = false;
+        }
+        park(state_, key);
+    }
+
+    static void park(const std::shared_ptr<State>& state, const std::string& key) {
+        std::lock_guard<std::mutex> lk(state->parked_mtx);
+        state->parked.push_back(key);
+        state->parked_count.store(state->parked.size(), std::memory_order_relaxed);
+    }
+
+    // Schedule drains for parked keys that still have tasks and no drain;
+    // a key refused again is parked for the next attempt
+    static void retry_parked(const std::shared_ptr<State>& state) {
+        std::vector<std::string> keys;
+        {
+            std::lock_guard<std::mutex> lk(state->parked_mtx);
+            keys.swap(state->parked);
+            state->parked_count.store(0, std::memory_order_relaxed);
+        }
+        for (const auto& key : keys) {
+            Shard& shard = state->shard_for(key);
+            TaskPriority priority;
+            {
+                std::lock_guard<std::mutex> lk(shard.mtx);
+                auto it = shard.strands.find(key);
+                if (it == shard.strands.end() || it->second.scheduled) {
+                    continue;  // Drained or rescheduled by a submit meanwhile
+                }
+                it->second.scheduled = true;
+                priority = it->second.priority;
+            }
+            if (schedule_drain(state, key, priority)) {
+                continue;
+            }
+            if (state->pool.is_shutdown()) {
+                drain(state, key);
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lk(shard.mtx);
+                shard.strands.find(key)->second.scheduled = false;
+            }
+            park(state, key);
+        }
+    }
+
+    static bool schedule_drain(const std::shared_ptr<State>& state,
+                               const std::string& key, TaskPriority priority) {
+        return state->pool.submit([state, key]() { drain(state, key); }, priority);
+    }
+
+    static void drain(const std::shared_ptr<State>& state, const std::string& key) {
+        Shard& shard = state->shard_for(key);
+        for (size_t ran = 0;; ++ran) {
+            InlineTask task;
+            TaskPriority priority;
+            {
+                std::lock_guard<std::mutex> lk(shard.mtx);
+                auto it = shard.strands.find(key);
+                if (ran > 0) {
+                    it->second.tasks.pop_front();  // Finished task stays queued while it runs
+                    if (it->second.tasks.empty()) {
+                        shard.strands.erase(it);
+                        break;
+                    }
+                }
+                priority = it->second.priority;
+                if (ran == kDrainBurst) {
+                    // Yield the worker; the key stays marked busy until the resubmitted drain
+                    if (schedule_drain(state, key, priority)) {
+                        return;
+                    }
+                    ran = 0;  // Pool shut down or full: keep draining on this worker
+                }
+                task = std::move(it->second.tasks.front());
+            }
+            try {
+                task();
+            } catch (...) {
+                // Same policy as ThreadPool: a failing task must not stall its key
+            }
+        }
+        // The pool just had room for this drain; give parked keys their turn
+        if (state->parked_count.load(std::memory_order_relaxed) > 0) {
+            retry_parked(state);
+        }
+    }
+
+    std::shared_ptr<State> state_;
+};
@@ -12,6 +12,8 @@
 #include <csignal>
 #include <mutex>
 #include <cstdlib>
+#include <cstdint>
+#include <string_view>
 
 #ifdef HAVE_SPDLOG
 #include <spdlog/spdlog.h>
@@ -21,11 +23,15 @@
 #include <fmt/format.h>
 #endif
 
+class RequestContext;
+
 /**
  * Structured logging system with correlation IDs and dynamic log levels
  * Supports both spdlog (when available) and simple stdout fallback
  */
 class Logger {
+    friend class RequestContext;
+
 public:
     enum class Level {
         TRACE = 0,
@@ -179,6 +185,9 @@ public:
         return std::make_shared<Logger>(service_name_, generate_correlation_id(), generate_trace_id(), generate_span_id());
     }
 
+    // Cheap request-scoped context sharing this logger's sinks; see RequestContext
+    RequestContext create_request_context() const;
+
     // Create span logger with new span ID but same trace
     std::shared_ptr<Logger> create_span_logger(const std::string& operation_name = "") const {
         std::string service = operation_name.empty() ? service_name_ : service_name_ + "::" + operation_name;
@@ -191,7 +200,14 @@ public:
         if (level < global_level_.load()) {
             return; // Skip if below current log level
         }
+        emit(level, correlation_id_, trace_id_, span_id_, format, std::forward<Args>(args)...);
+    }
 
+private:
+    // Write one structured line with the given trace context
+    template<typename... Args>
+    void emit(Level level, std::string_view correlation_id, std::string_view trace_id,
+              std::string_view span_id, const std::string& format, Args&&... args) const {
 #ifdef HAVE_SPDLOG
         std::string message;
         if constexpr (sizeof...(args) > 0) {
@@ -203,7 +219,7 @@ public:
         // Create structured log with correlation_id, trace_id, and span_id
         std::string structured_message = fmt::format(
             "correlation_id={} trace_id={} span_id={} service={} message=\"{}\"",
-            correlation_id_, trace_id_, span_id_, service_name_, message
+            correlation_id, trace_id, span_id, service_name_, message
         );
         logger_->log(to_spdlog_level(level), structured_message);
 #else
@@ -223,14 +239,15 @@ public:
         std::cout << "[" << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S")
                   << "." << std::setfill('0') << std::setw(3) << ms.count() << "] "
                   << "[" << level_to_string(level) << "] "
-                  << "correlation_id=" << correlation_id_ << " "
-                  << "trace_id=" << trace_id_ << " "
-                  << "span_id=" << span_id_ << " "
+                  << "correlation_id=" << correlation_id << " "
+                  << "trace_id=" << trace_id << " "
+                  << "span_id=" << span_id << " "
                   << "service=" << service_name_ << " "
                   << "message=\"" << message << "\"" << std::endl;
 #endif
     }
 
+public:
     // Convenience methods
     template<typename... Args>
     void trace(const std::string& format, Args&&... args) {
@@ -304,7 +321,7 @@ public:
 private:
     // Simple fallback formatter for {} replacement when spdlog is not available
     template<typename T>
-    std::string format_fallback(const std::string& format, T&& arg) {
+    std::string format_fallback(const std::string& format, T&& arg) const {
         std::string result = format;
         size_t pos = result.find("{}");
         if (pos != std::string::npos) {
@@ -316,7 +333,7 @@ private:
     }
 
     template<typename T, typename... Args>
-    std::string format_fallback(const std::string& format, T&& arg, Args&&... args) {
+    std::string format_fallback(const std::string& format, T&& arg, Args&&... args) const {
         std::string result = format;
         size_t pos = result.find("{}");
         if (pos != std::string::npos) {
@@ -329,6 +346,113 @@ private:
     }
 };
 
+/**
+ * Request-scoped trace context that logs through an existing Logger
+ *
+ * What create_request_logger() gives a message handler (fresh correlation,
+ * trace and span IDs on every line) without building a Logger: the IDs
+ * are three integers drawn from a per-thread generator and only formatted
+ * as hex when a line is actually written, and output goes to the parent's
+ * sinks. Creating or copying one never allocates or makes a syscall, so
+ * the receive path can afford one per message.
+ *
+ * Holds a reference to the parent, which must outlive it (ServiceHost's
+ * logger outlives every handler).
+ */
+class RequestContext {
+public:
+    using Level = Logger::Level;
+
+    explicit RequestContext(const Logger& parent)
+        : parent_(&parent),
+          trace_id_(next_id()),
+          correlation_id_(static_cast<uint32_t>(next_id())),
+          span_id_(static_cast<uint32_t>(next_id())) {}
+
+    template<typename... Args>
+    void log(Level level, std::string_view format, Args&&... args) const {
+        if (level < Logger::get_level()) {
+            return;
+        }
+        char correlation[8];
+        char trace[16];
+        char span[8];
+        parent_->emit(level, to_hex(correlation_id_, correlation), to_hex(trace_id_, trace),
+                      to_hex(span_id_, span), std::string(format), std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void trace(std::string_view format, Args&&... args) const {
+        log(Level::TRACE, format, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void debug(std::string_view format, Args&&... args) const {
+        log(Level::DEBUG, format, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void info(std::string_view format, Args&&... args) const {
+        log(Level::INFO, format, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void warn(std::string_view format, Args&&... args) const {
+        log(Level::WARN, format, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void error(std::string_view format, Args&&... args) const {
+        log(Level::ERROR, format, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void critical(std::string_view format, Args&&... args) const {
+        log(Level::CRITICAL, format, std::forward<Args>(args)...);
+    }
+
+    // Same formats as Logger's IDs (8, 16 and 8 hex characters)
+    std::string get_correlation_id() const { char b[8]; return std::string(to_hex(correlation_id_, b)); }
+    std::string get_trace_id() const { char b[16]; return std::string(to_hex(trace_id_, b)); }
+    std::string get_span_id() const { char b[8]; return std::string(to_hex(span_id_, b)); }
+
+    // Full Logger with this context's IDs, for code that needs one
+    std::shared_ptr<Logger> to_logger() const {
+        return std::make_shared<Logger>(parent_->get_service_name(), get_correlation_id(),
+                                        get_trace_id(), get_span_id());
+    }
+
+private:
+    // splitmix64 over a per-thread state seeded once from random_device
+    static uint64_t next_id() {
+        thread_local uint64_t state = (static_cast<uint64_t>(std::random_device{}()) << 32) ^
+                                      std::random_device{}();
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // Lower-case hex of 'value' filling all N characters of 'out'
+    template<size_t N>
+    static std::string_view to_hex(uint64_t value, char (&out)[N]) {
+        static constexpr char digits[] = "0123456789abcdef";
+        for (size_t i = N; i-- > 0; value >>= 4) {
+            out[i] = digits[value & 0xf];
+        }
+        return std::string_view(out, N);
+    }
+
+    const Logger* parent_;
+    uint64_t trace_id_;
+    uint32_t correlation_id_;
+    uint32_t span_id_;
+};
+
+inline RequestContext Logger::create_request_context() const {
+    return RequestContext(*this);
+}
+
 // Convenient macros for the current logger instance
 #define LOG_TRACE(...) if(auto log = Logger::instance_) log->trace(__VA_ARGS__)
 #define LOG_DEBUG(...) if(auto log = Logger::instance_) log->debug(__VA_ARGS__)
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_span)
+#include <span>
+#endif
+
+#include "message_buffer.hpp"
+
+// Read-only view of one parsed batch: std::span<const T> in C++20 builds,
+// a minimal stand-in with the same shape otherwise
+#if defined(__cpp_lib_span)
+template <typename T>
+using BatchView = std::span<const T>;
+#else
+template <typename T>
+class BatchView {
+public:
+    BatchView(const T* data, size_t size) : data_(data), size_(size) {}
+
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+
+private:
+    const T* data_;
+    size_t size_;
+};
+#endif
+
+/**
+ * @brief Groups received payloads of one message type into batches
+ *
+ * add() is called on the receiving thread for every message and only
+ * appends under a mutex. A batch is handed to 'dispatch' (typically one
+ * ThreadPool submission) when it reaches max_batch messages, or once
+ * max_delay has passed since its first message: an add() that finds the
+ * batch overdue flushes it on the spot, and the owner calls flush_if_due()
+ * periodically so a partial batch also goes out when traffic stops. No
+ * per-batch timer is armed. flush() dispatches whatever is pending
+ * (shutdown). 'dispatch' runs outside the lock.
+ */
+class MessageBatcher {
+public:
+    using Batch = std::vector<MessageBuffer>;
+    using Dispatch = std::function<void(Batch&& batch)>;
+    using Clock = std::chrono::steady_clock;
+
+    MessageBatcher(size_t max_batch, std::chrono::milliseconds max_delay, Dispatch dispatch)
+        : max_batch_(max_batch > 0 ? max_batch : 1),
+          max_delay_(max_delay),
+          dispatch_(std::move(dispatch)) {
+        pending_.reserve(max_batch_);
+    }
+
+    MessageBatcher(const MessageBatcher&) = delete;
+    MessageBatcher& operator=(const MessageBatcher&) = delete;
+
+    void add(MessageBuffer payload) {
+        const auto now = Clock::now();
+        Batch ready;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (pending_.empty()) {
+                first_arrival_ = now;
+            }
+            pending_.push_back(std::move(payload));
+            if (pending_.size() >= max_batch_ || now - first_arrival_ >= max_delay_) {
+                take(ready);
+            }
+        }
+        if (!ready.empty()) {
+            dispatch_(std::move(ready));
+        }
+    }
+
+    // Dispatch the pending batch if max_delay has passed since its first message
+    void flush_if_due(Clock::time_point now = Clock::now()) {
+        Batch ready;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (!pending_.empty() && now - first_arrival_ >= max_delay_) {
+                take(ready);
+            }
+        }
+        if (!ready.empty()) {
+            dispatch_(std::move(ready));
+        }
+    }
+
+    // Dispatch the pending batch, if any
+    void flush() {
+        Batch ready;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            take(ready);
+        }
+        if (!ready.empty()) {
+            dispatch_(std::move(ready));
+        }
+    }
+
+    size_t max_batch() const { return max_batch_; }
+    std::chrono::milliseconds max_delay() const { return max_delay_; }
+
+private:
+    // Move the pending batch into 'out' and start the next one; holds mtx_
+    void take(Batch& out) {
+        if (pending_.empty()) {
+            return;
+        }
+        out.swap(pending_);
+        pending_.reserve(max_batch_);
+    }
+
+    const size_t max_batch_;
+    const std::chrono::milliseconds max_delay_;
+    const Dispatch dispatch_;
+
+    std::mutex mtx_;
+    Batch pending_;
+    Clock::time_point first_arrival_;
+};
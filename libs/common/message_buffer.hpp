@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <nats/nats.h>
+
+/**
+ * @brief Ref-counted, read-only view of one received message body
+ *
+ * adopt() takes ownership of a natsMsg and calls natsMsg_Destroy when the
+ * last copy is dropped, so the payload is read straight out of the NATS
+ * client's buffer by whichever worker parses it, with no copy in between.
+ * Copies share the message (one atomic increment); moves are free. The
+ * message's reply subject, if its sender expects an answer, stays readable
+ * through reply().
+ *
+ * copy_of() wraps a payload that did not come from NATS (tests, the
+ * std::string overload of ServiceHost::receive_message).
+ */
+class MessageBuffer {
+public:
+    MessageBuffer() = default;
+
+    static MessageBuffer adopt(natsMsg* msg) {
+        MessageBuffer buffer;
+        buffer.owner_ = std::shared_ptr<natsMsg>(msg, natsMsg_Destroy);
+        buffer.data_ = std::string_view(natsMsg_GetData(msg),
+                                        static_cast<size_t>(natsMsg_GetDataLength(msg)));
+        if (const char* reply = natsMsg_GetReply(msg)) {
+            buffer.reply_ = reply;
+        }
+        return buffer;
+    }
+
+    static MessageBuffer copy_of(std::string payload) {
+        auto owned = std::make_shared<const std::string>(std::move(payload));
+        MessageBuffer buffer;
+        buffer.data_ = *owned;
+        buffer.owner_ = std::move(owned);
+        return buffer;
+    }
+
+    std::string_view view() const { return data_; }
+    const char* data() const { return data_.data(); }
+    size_t size() const { return data_.size(); }
+    bool empty() const { return data_.empty(); }
+    std::string_view reply() const { return reply_; }  // Empty if none
+
+private:
+    std::shared_ptr<const void> owner_;  // natsMsg or std::string backing data_
+    std::string_view data_;
+    std::string_view reply_;
+};
@@ -2,18 +2,29 @@
 
 #include "service_host.hpp"
 #include <functional>
+#include <string>
 
 // A simple value type for one message registration
 template<typename T>
 struct MessageRegistration {
     MessageRouting routing;
     std::function<void(const T&)> handler;
+    TaskPriority priority = TaskPriority::Normal;
+    std::function<std::string(const T&)> key_extractor;  // Optional per-key ordering
 
     void Register(ServiceHost* host) const {
-        host->register_message<T>(routing, handler);
+        host->register_message<T>(routing, handler, key_extractor, priority);
     }
 };
 
 // Macro for concise declarations
 #define MSG_REG(TYPE, ROUTING, HANDLER) \
     MessageRegistration<TYPE>{ROUTING, HANDLER}
+
+// Same, on an explicit ThreadPool lane (e.g. TaskPriority::High for health checks)
+#define MSG_REG_PRIORITY(TYPE, ROUTING, HANDLER, PRIORITY) \
+    MessageRegistration<TYPE>{ROUTING, HANDLER, PRIORITY}
+
+// Same, with handlers for equal keys run in arrival order (e.g. by account_id)
+#define MSG_REG_KEYED(TYPE, ROUTING, HANDLER, KEY_EXTRACTOR) \
+    MessageRegistration<TYPE>{ROUTING, HANDLER, TaskPriority::Normal, KEY_EXTRACTOR}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue
+ *
+ * Dmitry Vyukov's bounded MPMC design: a power-of-two array of cells, each
+ * carrying a sequence number that tells producers and consumers whether the
+ * cell is free for the current lap. A push or pop is one CAS on the shared
+ * enqueue/dequeue position plus a release store to the cell; there is no
+ * lock and no allocation after construction. Elements are moved in and out.
+ *
+ * try_push()/try_pop() never block and fail when the ring is full/empty.
+ * The ring is lock-free but not wait-free: a producer preempted between
+ * claiming a cell and publishing it makes that cell look empty to consumers
+ * until it resumes.
+ */
+template <typename T>
+class MpmcRing {
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "MpmcRing moves elements in place and cannot roll back a throwing move");
+
+public:
+    // Capacity is rounded up to a power of two (at least 2)
+    explicit MpmcRing(size_t capacity)
+        : mask_(round_up(capacity) - 1), cells_(new Cell[mask_ + 1]) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    ~MpmcRing() {
+        // Destroy whatever is still queued; no concurrent users by now
+        for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed);; ++pos) {
+            Cell& cell = cells_[pos & mask_];
+            if (cell.sequence.load(std::memory_order_relaxed) != pos + 1) {
+                break;
+            }
+            cell.value()->~T();
+        }
+    }
+
+    // Moves 'value' in only on success; on failure it is left untouched
+    template <typename U>
+    bool try_push(U&& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Full: the cell still holds last lap's element
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (static_cast<void*>(cell->storage)) T(std::forward<U>(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Empty, or the producer has not published yet
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        T* value = cell->value();
+        out = std::move(*value);
+        value->~T();
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // Racy snapshot, for metrics only
+    size_t size_approx() const {
+        const size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        const size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    static size_t round_up(size_t n) {
+        size_t capacity = 2;
+        while (capacity < n) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};  // Producers and consumers on separate lines
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+/**
+ * @brief Fork-join loops on a ThreadPool: parallel_for,
+ * parallel_transform_reduce and parallel_sort
+ *
+ * The range is split on the fly rather than up front. Participants (the
+ * calling thread plus up to pool.size() helper tasks) claim chunks from a
+ * shared cursor with one CAS each; a chunk is half the remaining range
+ * divided among the participants, but never less than the grain. Early
+ * chunks are large and the tail is cut fine, so uneven per-element cost
+ * balances itself. A grain of 0 picks one sixteenth of a participant's
+ * share.
+ *
+ * The caller does not block while work is left: it runs chunks itself and
+ * only waits for chunks other threads are already running. Helper tasks
+ * still queued when the range runs out find nothing to claim and return.
+ * That makes the calls safe from inside a pool worker (including nested
+ * calls) and on a busy or refused pool: in the worst case the caller does
+ * the whole range. Body exceptions stop further claims and the first one
+ * is rethrown to the caller once in-flight chunks have finished.
+ */
+
+namespace parallel_detail {
+
+// Shared by the caller and its helper tasks; outlives the call while
+// helpers are still queued, but 'body' is only touched by a participant
+// that won a chunk, which cannot happen after the caller has returned.
+struct ForkJoin {
+    using Body = void (*)(void* body, size_t begin, size_t end, size_t participant);
+
+    ForkJoin(size_t n, size_t min_chunk, size_t threads, Body fn, void* arg)
+        : count(n), grain(min_chunk), participants(threads), run(fn), body(arg) {}
+
+    const size_t count;
+    const size_t grain;
+    const size_t participants;
+    const Body run;
+    void* const body;
+
+    std::atomic<size_t> next{0};       // First unclaimed index
+    std::atomic<size_t> in_flight{0};  // Participants between entry and exit
+    std::mutex mtx;
+    std::condition_variable idle;
+    std::exception_ptr error;  // First body exception; guarded by 'mtx'
+
+    bool claim(size_t& begin, size_t& end) {
+        size_t current = next.load(std::memory_order_relaxed);
+        while (current < count) {
+            const size_t chunk = std::max(grain, (count - current) / (2 * participants));
+            const size_t stop = std::min(count, current + chunk);
+            if (next.compare_exchange_weak(current, stop, std::memory_order_acq_rel)) {
+                begin = current;
+                end = stop;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Run chunks until none are left
+    void work(size_t participant) {
+        in_flight.fetch_add(1, std::memory_order_acq_rel);
+        size_t begin = 0;
+        size_t end = 0;
+        while (claim(begin, end)) {
+            try {
+                run(body, begin, end, participant);
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lk(mtx);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+                next.store(count, std::memory_order_release);  // Abandon the rest
+            }
+        }
+        if (in_flight.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lk(mtx);
+            idle.notify_all();
+        }
+    }
+};
+
+// Participants for 'count' elements in chunks of at least 'grain'
+inline size_t participants_for(const ThreadPool& pool, size_t count, size_t grain) {
+    if (grain == 0 || pool.is_shutdown()) {
+        return 1;
+    }
+    const size_t chunks = (count + grain - 1) / grain;
+    return std::max<size_t>(1, std::min(pool.size() + 1, chunks));
+}
+
+// Resolve a grain of 0 to one sixteenth of a participant's share
+inline size_t grain_for(const ThreadPool& pool, size_t count, size_t grain) {
+    if (grain > 0) {
+        return grain;
+    }
+    return std::max<size_t>(1, count / ((pool.size() + 1) * 16));
+}
+
+// Call body(begin, end, participant) over [0, count) on 'participants'
+// threads; participant 0 is the caller
+template <typename Body>
+void run_chunks(ThreadPool& pool, size_t count, size_t grain, size_t participants, Body& body) {
+    if (count == 0) {
+        return;
+    }
+    if (participants <= 1) {
+        body(size_t{0}, count, size_t{0});
+        return;
+    }
+
+    auto state = std::make_shared<ForkJoin>(
+        count, grain, participants,
+        [](void* erased, size_t begin, size_t end, size_t participant) {
+            (*static_cast<Body*>(erased))(begin, end, participant);
+        },
+        static_cast<void*>(std::addressof(body)));
+
+    for (size_t participant = 1; participant < participants; ++participant) {
+        if (!pool.submit([state, participant]() { state->work(participant); })) {
+            break;  // Refused: the participants already running cover the range
+        }
+    }
+    state->work(0);
+
+    std::unique_lock<std::mutex> lk(state->mtx);
+    state->idle.wait(lk, [&]() { return state->in_flight.load(std::memory_order_acquire) == 0; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+}  // namespace parallel_detail
+
+// Call body(i) for every i in [first, last). 'grain' is the smallest
+// chunk handed to one thread (0 = adaptive).
+template <typename Index, typename Body,
+          std::enable_if_t<std::is_integral_v<Index>, int> = 0>
+void parallel_for(ThreadPool& pool, Index first, Index last, Body&& body, size_t grain = 0) {
+    if (!(first < last)) {
+        return;
+    }
+    const size_t count = static_cast<size_t>(last - first);
+    grain = parallel_detail::grain_for(pool, count, grain);
+    auto chunk = [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+            body(static_cast<Index>(first + static_cast<Index>(i)));
+        }
+    };
+    parallel_detail::run_chunks(pool, count, grain,
+                                parallel_detail::participants_for(pool, count, grain), chunk);
+}
+
+// Parallel std::transform_reduce over random-access [first, last):
+// reduce(init, transform(x)...) in unspecified order and grouping, so
+// 'reduce' must be associative and commutative (floating-point sums may
+// differ from a serial loop in the last bits).
+template <typename It, typename T, typename Reduce, typename Transform>
+T parallel_transform_reduce(ThreadPool& pool, It first, It last, T init, Reduce reduce,
+                            Transform transform, size_t grain = 0) {
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<It>::iterator_category>,
+                  "parallel_transform_reduce needs random-access iterators");
+    const size_t count = static_cast<size_t>(std::distance(first, last));
+    if (count == 0) {
+        return init;
+    }
+    grain = parallel_detail::grain_for(pool, count, grain);
+    const size_t participants = parallel_detail::participants_for(pool, count, grain);
+
+    // One accumulator per participant, each on its own cache line
+    struct alignas(64) Partial {
+        std::optional<T> value;
+    };
+    std::vector<Partial> partials(participants);
+    auto chunk = [&](size_t begin, size_t end, size_t participant) {
+        std::optional<T>& acc = partials[participant].value;
+        for (size_t i = begin; i < end; ++i) {
+            if (acc) {
+                *acc = reduce(std::move(*acc), transform(first[i]));
+            } else {
+                acc.emplace(transform(first[i]));
+            }
+        }
+    };
+    parallel_detail::run_chunks(pool, count, grain, participants, chunk);
+
+    for (auto& partial : partials) {
+        if (partial.value) {
+            init = reduce(std::move(init), std::move(*partial.value));
+        }
+    }
+    return init;
+}
+
+// Sort random-access [first, last) with 'comp': blocks are sorted in
+// parallel, then merged pairwise in parallel rounds. Not stable. Ranges
+// below kParallelSortCutoff elements just use std::sort.
+inline constexpr size_t kParallelSortCutoff = 16384;
+
+template <typename It, typename Compare = std::less<>>
+void parallel_sort(ThreadPool& pool, It first, It last, Compare comp = Compare()) {
+    const size_t count = static_cast<size_t>(std::distance(first, last));
+    const size_t blocks = std::min(pool.size() + 1, count / (kParallelSortCutoff / 2));
+    if (count < kParallelSortCutoff || blocks < 2 || pool.is_shutdown()) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<size_t> bounds(blocks + 1);
+    for (size_t b = 0; b <= blocks; ++b) {
+        bounds[b] = count * b / blocks;
+    }
+    parallel_for(pool, size_t{0}, blocks, [&](size_t b) {
+        std::sort(first + bounds[b], first + bounds[b + 1], comp);
+    }, 1);
+
+    // Merge runs of 'width' blocks into runs of 2 * width
+    for (size_t width = 1; width < blocks; width *= 2) {
+        const size_t pairs = (blocks + 2 * width - 1) / (2 * width);
+        parallel_for(pool, size_t{0}, pairs, [&](size_t pair) {
+            const size_t lo = bounds[2 * pair * width];
+            const size_t mid = bounds[std::min((2 * pair + 1) * width, blocks)];
+            const size_t hi = bounds[std::min((2 * pair + 2) * width, blocks)];
+            if (mid < hi) {
+                std::inplace_merge(first + lo, first + mid, first + hi, comp);
+            }
+        }, 1);
+    }
+}
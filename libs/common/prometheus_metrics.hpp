@@ -2,6 +2,8 @@
 
 #include <string>
 #include <unordered_map>
+#include <map>
+#include <utility>
 #include <atomic>
 #include <chrono>
 #include <mutex>
@@ -150,9 +152,10 @@ public:
         }
     }
     
+    // Lock-free: the bucket map is fixed at construction and every count
+    // is atomic, so publishing threads never wait on each other here. A
+    // scrape may see count and buckets one observation apart.
     void observe(double value) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
         // Increment count
         uint64_t old_count = count_.load();
         while (!count_.compare_exchange_weak(old_count, old_count + 1)) {
@@ -172,6 +175,17 @@ public:
         }
     }
     
+    // Overwrite the histogram with totals aggregated elsewhere (e.g. per-thread
+    // counters). 'cumulative[i]' is the number of observations <= buckets[i].
+    void set_snapshot(const std::vector<uint64_t>& cumulative, uint64_t count, double sum) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < buckets_.size() && i < cumulative.size(); ++i) {
+            bucket_counts_[buckets_[i]].store(cumulative[i]);
+        }
+        count_.store(count);
+        sum_.store(sum);
+    }
+    
     std::string serialize() const override {
         std::stringstream ss;
         ss << "# HELP " << name_ << " " << help_ << "\n";
@@ -239,22 +253,29 @@ public:
         return registry;
     }
     
-    void register_metric(std::shared_ptr<Metric> metric) {
+    // Series are keyed by name and labels, so one metric name can carry
+    // several label sets (e.g. one series per worker)
+    void register_metric(std::shared_ptr<Metric> metric,
+                         const std::unordered_map<std::string, std::string>& labels = {}) {
+        std::string label_key;
+        for (const auto& [label, val] : std::map<std::string, std::string>(labels.begin(), labels.end())) {
+            label_key += label + "=" + val + ",";
+        }
         std::lock_guard<std::mutex> lock(mutex_);
-        metrics_[metric->name()] = metric;
+        metrics_[{metric->name(), label_key}] = metric;
     }
     
     std::shared_ptr<Counter> create_counter(const std::string& name, const std::string& help,
                                            const std::unordered_map<std::string, std::string>& labels = {}) {
         auto counter = std::make_shared<Counter>(name, help, labels);
-        register_metric(counter);
+        register_metric(counter, labels);
         return counter;
     }
     
     std::shared_ptr<Gauge> create_gauge(const std::string& name, const std::string& help,
                                        const std::unordered_map<std::string, std::string>& labels = {}) {
         auto gauge = std::make_shared<Gauge>(name, help, labels);
-        register_metric(gauge);
+        register_metric(gauge, labels);
         return gauge;
     }
     
@@ -262,7 +283,7 @@ public:
                                                const std::vector<double>& buckets = {0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0},
                                                const std::unordered_map<std::string, std::string>& labels = {}) {
         auto histogram = std::make_shared<Histogram>(name, help, buckets, labels);
-        register_metric(histogram);
+        register_metric(histogram, labels);
         return histogram;
     }
     
@@ -270,8 +291,30 @@ public:
         std::lock_guard<std::mutex> lock(mutex_);
         std::stringstream ss;
         
-        for (const auto& [name, metric] : metrics_) {
-            ss << metric->serialize() << "\n";
+        // Keys are (name, labels) pairs, so series of one family are
+        // adjacent; HELP/TYPE are emitted once per family
+        const std::string* family = nullptr;
+        for (const auto& [key, metric] : metrics_) {
+            std::string text = metric->serialize();
+            if (!family || *family != metric->name()) {
+                if (family) {
+                    ss << "\n";
+                }
+            } else {
+                std::stringstream lines(text);
+                std::string line;
+                text.clear();
+                while (std::getline(lines, line)) {
+                    if (line.rfind("# ", 0) != 0) {
+                        text += line + "\n";
+                    }
+                }
+            }
+            family = &metric->name();
+            ss << text;
+        }
+        if (family) {
+            ss << "\n";
         }
         
         return ss.str();
@@ -284,7 +327,7 @@ public:
 
 private:
     MetricsRegistry() = default;
-    std::unordered_map<std::string, std::shared_ptr<Metric>> metrics_;
+    std::map<std::pair<std::string, std::string>, std::shared_ptr<Metric>> metrics_;  // (name, labels)
     mutable std::mutex mutex_;
 };
 
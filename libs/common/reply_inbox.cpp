@@ -0,0 +1,169 @@
+#include "reply_inbox.hpp"
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// The server answers a request nobody subscribes to with an empty message
+// carrying a 503 status header
+bool is_no_responders(natsMsg *msg) {
+    if (natsMsg_GetDataLength(msg) != 0) {
+        return false;
+    }
+    const char *status = nullptr;
+    return natsMsgHeader_Get(msg, "Status", &status) == NATS_OK && status &&
+           std::strcmp(status, "503") == 0;
+}
+
+} // namespace
+
+ReplyInbox::ReplyInbox(natsConnection *conn) : conn_(conn) {}
+
+ReplyInbox::~ReplyInbox() {
+    close();
+}
+
+natsStatus ReplyInbox::start() {
+    natsInbox *inbox = nullptr;
+    natsStatus s = natsInbox_Create(&inbox);
+    if (s != NATS_OK) {
+        return s;
+    }
+    prefix_ = inbox;
+    natsInbox_Destroy(inbox);
+
+    const std::string wildcard = prefix_ + ".*";
+    s = natsConnection_Subscribe(&sub_, conn_, wildcard.c_str(), &ReplyInbox::on_reply, this);
+    if (s != NATS_OK) {
+        sub_ = nullptr;
+        return s;
+    }
+    timer_ = std::thread([this]() { timeout_loop(); });
+    return NATS_OK;
+}
+
+natsStatus ReplyInbox::request(const std::string &subject, std::string_view payload,
+                               std::chrono::milliseconds timeout, Completion done) {
+    const uint64_t id = next_id_.fetch_add(1, std::memory_order_relaxed);
+    const std::string reply = prefix_ + "." + std::to_string(id);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    // Registered before publishing: the reply can beat the publish call back
+    {
+        std::unique_lock<std::mutex> lk(mtx_);
+        if (closed_ || !sub_) {
+            lk.unlock();
+            done(MessageBuffer(), "reply inbox closed");
+            return NATS_CONNECTION_CLOSED;
+        }
+        pending_.emplace(id, std::move(done));
+        const bool earliest = deadlines_.empty() || deadline < deadlines_.top().first;
+        deadlines_.emplace(deadline, id);
+        if (earliest) {
+            wake_.notify_one();
+        }
+    }
+
+    natsStatus s = natsConnection_PublishRequest(conn_, subject.c_str(), reply.c_str(), payload.data(),
+                                                 static_cast<int>(payload.size()));
+    if (s != NATS_OK) {
+        // Never sent. The timeout thread or close() may have completed it
+        // already while the publish was blocked; otherwise fail it here
+        if (Completion failed = take(id)) {
+            failed(MessageBuffer(), natsStatus_GetText(s));
+        }
+    }
+    return s;
+}
+
+void ReplyInbox::close() {
+    std::unordered_map<uint64_t, Completion> abandoned;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        abandoned.swap(pending_);
+    }
+    wake_.notify_all();
+    if (timer_.joinable()) {
+        timer_.join();
+    }
+    if (sub_) {
+        natsSubscription_Unsubscribe(sub_);
+        natsSubscription_Destroy(sub_);
+        sub_ = nullptr;
+    }
+    for (auto &[id, done] : abandoned) {
+        done(MessageBuffer(), "reply inbox closed");
+    }
+}
+
+size_t ReplyInbox::pending() const {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return pending_.size();
+}
+
+void ReplyInbox::on_reply(natsConnection *, natsSubscription *, natsMsg *msg, void *closure) {
+    static_cast<ReplyInbox *>(closure)->deliver(msg);
+}
+
+void ReplyInbox::deliver(natsMsg *msg) {
+    const char *subject = natsMsg_GetSubject(msg);
+    Completion done;
+    if (std::strlen(subject) > prefix_.size() + 1) {
+        done = take(std::strtoull(subject + prefix_.size() + 1, nullptr, 10));
+    }
+    if (!done) {
+        late_replies_.fetch_add(1, std::memory_order_relaxed);
+        natsMsg_Destroy(msg);
+        return;
+    }
+
+    if (is_no_responders(msg)) {
+        natsMsg_Destroy(msg);
+        done(MessageBuffer(), "no responders");
+        return;
+    }
+    replies_.fetch_add(1, std::memory_order_relaxed);
+    done(MessageBuffer::adopt(msg), nullptr);
+}
+
+ReplyInbox::Completion ReplyInbox::take(uint64_t id) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto it = pending_.find(id);
+    if (it == pending_.end()) {
+        return {};
+    }
+    Completion done = std::move(it->second);
+    pending_.erase(it);
+    return done;
+}
+
+void ReplyInbox::timeout_loop() {
+    std::unique_lock<std::mutex> lk(mtx_);
+    while (!closed_) {
+        if (deadlines_.empty()) {
+            wake_.wait(lk);
+            continue;
+        }
+        const Deadline next = deadlines_.top();
+        if (std::chrono::steady_clock::now() < next.first) {
+            wake_.wait_until(lk, next.first);
+            continue;
+        }
+        deadlines_.pop();
+        auto it = pending_.find(next.second);
+        if (it == pending_.end()) {
+            continue;  // Already replied
+        }
+        Completion done = std::move(it->second);
+        pending_.erase(it);
+        timeouts_.fetch_add(1, std::memory_order_relaxed);
+
+        lk.unlock();
+        done(MessageBuffer(), "timed out");
+        lk.lock();
+    }
+}
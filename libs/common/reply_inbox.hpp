@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <nats/nats.h>
+
+#include "message_buffer.hpp"
+
+/**
+ * @brief One shared reply subscription for all outstanding NATS requests
+ *
+ * start() creates a unique inbox prefix and subscribes once to
+ * "<prefix>.*". Each request() gets the next correlation id, is published
+ * with "<prefix>.<id>" as its reply subject and waits in a map keyed by
+ * that id; a reply is routed back by parsing the id out of its subject.
+ * Sending a request therefore costs one publish, not a subscribe, an
+ * unsubscribe and a per-request timer in the NATS client.
+ *
+ * Timeouts are kept in a deadline heap served by one thread. Whichever of
+ * reply, timeout or close() comes first removes the entry and runs its
+ * completion exactly once; a reply arriving after its timeout is dropped
+ * and counted in late_replies(). Completions run on the NATS delivery
+ * thread or the timeout thread and must not block.
+ */
+class ReplyInbox {
+public:
+    // 'error' is null on success; otherwise 'reply' is empty
+    using Completion = std::function<void(const MessageBuffer &reply, const char *error)>;
+
+    explicit ReplyInbox(natsConnection *conn);
+    ~ReplyInbox();
+
+    ReplyInbox(const ReplyInbox &) = delete;
+    ReplyInbox &operator=(const ReplyInbox &) = delete;
+
+    // Subscribe the shared inbox and start the timeout thread
+    natsStatus start();
+
+    // Publish 'payload' to 'subject' and call 'done' with the first reply,
+    // or with an error on timeout, no responders, close() or a failed
+    // publish. 'done' runs exactly once on every path, possibly before
+    // return; the status only reports whether the request was sent.
+    natsStatus request(const std::string &subject, std::string_view payload,
+                       std::chrono::milliseconds timeout, Completion done);
+
+    // Fail outstanding requests and release the subscription
+    void close();
+
+    const std::string &prefix() const { return prefix_; }
+    size_t pending() const;
+    uint64_t replies() const { return replies_.load(std::memory_order_relaxed); }
+    uint64_t timeouts() const { return timeouts_.load(std::memory_order_relaxed); }
+    uint64_t late_replies() const { return late_replies_.load(std::memory_order_relaxed); }
+
+private:
+    using Deadline = std::pair<std::chrono::steady_clock::time_point, uint64_t>;
+
+    static void on_reply(natsConnection *, natsSubscription *, natsMsg *msg, void *closure);
+    void deliver(natsMsg *msg);
+    void timeout_loop();
+    // Remove and return the completion for 'id'; empty if already finished
+    Completion take(uint64_t id);
+
+    natsConnection *conn_;
+    std::string prefix_;
+    natsSubscription *sub_ = nullptr;
+    std::thread timer_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable wake_;  // Signalled on an earlier deadline or close()
+    std::unordered_map<uint64_t, Completion> pending_;
+    // Entries whose request already finished stay until their deadline
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_;
+    bool closed_ = false;
+
+    std::atomic<uint64_t> next_id_{0};
+    std::atomic<uint64_t> replies_{0};
+    std::atomic<uint64_t> timeouts_{0};
+    std::atomic<uint64_t> late_replies_{0};
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <functional>
@@ -11,12 +12,21 @@
 #include <csignal>
 #include <chrono>
 #include <sstream>
-#include <future>         // For std::future, std::promise, std::async
+#include <type_traits>
 
 #include <nats/nats.h>
+#include <google/protobuf/arena.h>
 #include <google/protobuf/message.h>
 
 #include "thread_pool.hpp"
+#include "task_future.hpp"
+#include "coroutine_task.hpp"
+#include "keyed_executor.hpp"
+#include "conflating_inbox.hpp"
+#include "jetstream_consumer.hpp"
+#include "reply_inbox.hpp"
+#include "message_batcher.hpp"
+#include "message_buffer.hpp"
 #include "logger.hpp"
 #include "opentelemetry_integration.hpp"
 #include "configuration.hpp"
@@ -29,6 +39,79 @@
 class ServiceCache;
 class ServiceScheduler;
 
+namespace service_host_detail {
+
+// Messages carrying a TraceMetadata (trace_metadata field) may set a deadline
+template <typename T, typename = void>
+struct has_trace_metadata : std::false_type {};
+
+template <typename T>
+struct has_trace_metadata<T, std::void_t<decltype(std::declval<const T &>().trace_metadata().deadline_unix_ms())>>
+    : std::true_type {};
+
+// Map an absolute Unix-epoch deadline (ms) onto the steady clock; 0 = none
+inline ThreadPool::Deadline deadline_from_unix_ms(int64_t unix_ms)
+{
+    if (unix_ms <= 0)
+        return ThreadPool::kNoDeadline;
+    const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                               std::chrono::system_clock::now().time_since_epoch())
+                               .count();
+    return std::chrono::steady_clock::now() + std::chrono::milliseconds(unix_ms - now_ms);
+}
+
+// Per-thread protobuf arena for messages parsed on pool workers. The first
+// block is owned here and survives Reset(), so a message that fits in it
+// is parsed without touching the heap. Scopes nest (a worker may run
+// another receive job inline); the arena is reset when the outermost
+// scope ends, i.e. after the handler returns.
+class ParseArena
+{
+public:
+    static constexpr size_t kInitialBlock = 64 * 1024;
+
+    class Scope
+    {
+    public:
+        Scope() : local_(instance()) { ++local_.depth_; }
+        ~Scope()
+        {
+            if (--local_.depth_ == 0)
+                local_.arena_.Reset();
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        google::protobuf::Arena &arena() { return local_.arena_; }
+
+    private:
+        ParseArena &local_;
+    };
+
+private:
+    ParseArena() : block_(new char[kInitialBlock]), arena_(options(block_.get())) {}
+
+    static ParseArena &instance()
+    {
+        thread_local ParseArena local;
+        return local;
+    }
+
+    static google::protobuf::ArenaOptions options(char *block)
+    {
+        google::protobuf::ArenaOptions opts;
+        opts.initial_block = block;
+        opts.initial_block_size = kInitialBlock;
+        return opts;
+    }
+
+    std::unique_ptr<char[]> block_;
+    google::protobuf::Arena arena_;
+    size_t depth_ = 0;
+};
+
+} // namespace service_host_detail
+
 // Service initialization configuration
 struct ServiceInitConfig {
     // NATS Configuration
@@ -99,9 +182,23 @@ struct ServiceInitConfig {
 enum class MessageRouting
 {
     Broadcast,
-    PointToPoint
+    PointToPoint,
+    QueueGroup // Broadcast subject, but each message reaches one instance of
+               // this service (NATS queue group "nats.queue_group", default
+               // the service name); other services still each get a copy
 };
 
+inline const char *routing_name(MessageRouting routing)
+{
+    switch (routing)
+    {
+    case MessageRouting::Broadcast: return "Broadcast";
+    case MessageRouting::PointToPoint: return "PointToPoint";
+    case MessageRouting::QueueGroup: return "QueueGroup";
+    }
+    return "Unknown";
+}
+
 class ServiceHost
 {
 public:
@@ -111,7 +208,7 @@ public:
                 Regs &&...regs)
         : uid_(uid), service_name_(service_name),
           config_("config.yaml"),
-          thread_pool_(config_.get<size_t>("threads", std::thread::hardware_concurrency())),
+          thread_pool_(thread_pool_options(config_)),
           logger_(std::make_shared<Logger>(service_name_, uid)),
           tracing_enabled_(false),
           publish_broadcast_impl_(&ServiceHost::publish_broadcast_fast),
@@ -168,7 +265,7 @@ public:
                 Regs &&...regs)
         : uid_(uid), service_name_(service_name),
           config_(config_file),
-          thread_pool_(config_.get<size_t>("threads", std::thread::hardware_concurrency())),
+          thread_pool_(thread_pool_options(config_)),
           logger_(std::make_shared<Logger>(service_name_, uid)),
           tracing_enabled_(false),
           publish_broadcast_impl_(&ServiceHost::publish_broadcast_fast),
@@ -199,11 +296,81 @@ public:
     {
         return logger_->create_request_logger();
     }
+    // Per-message trace context on the service logger's sinks; no allocation
+    RequestContext create_request_context() const
+    {
+        return logger_->create_request_context();
+    }
+
+    // Messages NATS delivered to this instance for 'type_name', over all
+    // its subscriptions; with QueueGroup routing, compare across instances
+    size_t delivered_messages(const std::string &type_name) const;
 
     // Thread pool access
     ThreadPool& get_thread_pool() { return thread_pool_; }
     const ThreadPool& get_thread_pool() const { return thread_pool_; }
 
+    // NATS request/reply without blocking: publish 'payload' to 'subject'
+    // with a reply subject on this service's shared inbox; the future
+    // completes with the first reply's payload, or fails with
+    // std::runtime_error on timeout, when nobody is subscribed or when the
+    // request cannot be sent. Continuations run on the pool.
+    TaskFuture<std::string> request_async(const std::string &subject,
+                                          const std::string &payload,
+                                          std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
+    // Typed request/reply with the service 'target_uid': 'msg' goes to its
+    // PointToPoint subject and the future (co_await-able in a coroutine
+    // handler) completes with the Resp that the target's
+    // register_request_handler<Req, Resp> returned. Fails like
+    // request_async, or when the reply does not parse as Resp. All requests
+    // share one inbox subscription, so many can be in flight at low cost.
+    template <typename Req, typename Resp>
+    TaskFuture<Resp> request(const std::string &target_uid, const Req &msg,
+                             std::chrono::milliseconds timeout = std::chrono::seconds(5))
+    {
+        auto promise = std::make_shared<TaskPromise<Resp>>(&thread_pool_);
+        TaskFuture<Resp> reply = promise->get_future();
+        std::string subject = "system.direct." + target_uid + "." + Req::descriptor()->full_name();
+        std::string payload;
+        if (!msg.SerializeToString(&payload))
+        {
+            promise->set_exception(std::make_exception_ptr(
+                std::runtime_error("request to " + subject + " failed: cannot serialize")));
+            return reply;
+        }
+        send_request(subject, payload, timeout,
+                     [promise, subject](const MessageBuffer &payload, const char *error)
+                     {
+                         if (error)
+                         {
+                             promise->set_exception(std::make_exception_ptr(
+                                 std::runtime_error("request to " + subject + " failed: " + error)));
+                             return;
+                         }
+                         Resp response;
+                         if (!response.ParseFromArray(payload.data(), static_cast<int>(payload.size())))
+                         {
+                             promise->set_exception(std::make_exception_ptr(std::runtime_error(
+                                 "request to " + subject + " failed: reply is not a " +
+                                 Resp::descriptor()->full_name())));
+                             return;
+                         }
+                         promise->set_value(std::move(response));
+                     });
+        return reply;
+    }
+
+#if SERVICE_COROUTINES
+    // co_await resume_after(100ms) inside a coroutine handler: a timer on
+    // this service's scheduler that resumes on the pool
+    TimerAwaiter resume_after(std::chrono::milliseconds delay,
+                              TaskPriority priority = TaskPriority::Normal)
+    {
+        return ::resume_after(*scheduler_, delay, priority);
+    }
+#endif
+
     // 🚀 NEW: Simplified Handler Registration System
     // Handler takes raw payload; your logic will parse it
     using HandlerRaw = std::function<void(const std::string& payload)>;
@@ -347,17 +514,17 @@ public:
     // This method handles all service initialization and startup in one call
     void StartService(const ServiceInitConfig& config = {});
     
-    // 🚀 NEW: StartServiceAsync - Non-blocking service startup
+    // 🚀 NEW: StartServiceAsync - Non-blocking service startup on the thread pool
     // Returns a future that completes when service infrastructure is ready
-    std::future<void> StartServiceAsync(const ServiceInitConfig& config = {});
+    TaskFuture<void> StartServiceAsync(const ServiceInitConfig& config = {});
     
     // 🚀 NEW: StartServiceInfrastructureAsync - Initialize just the infrastructure
     // Returns a future for NATS, JetStream, and core systems initialization
-    std::future<void> StartServiceInfrastructureAsync(const ServiceInitConfig& config = {});
+    TaskFuture<void> StartServiceInfrastructureAsync(const ServiceInitConfig& config = {});
     
     // 🚀 NEW: CompleteServiceStartup - Complete startup after async infrastructure init
     // Call this after infrastructure future is ready to finish service setup
-    std::future<void> CompleteServiceStartup(const ServiceInitConfig& config = {});
+    TaskFuture<void> CompleteServiceStartup(const ServiceInitConfig& config = {});
     
     // 🚀 NEW: Permanent Service Maintenance Tasks
     // Start automatic service maintenance tasks (metrics, health, backpressure)
@@ -446,9 +613,10 @@ public:
     }
 
     // Thread pool utilities
-    void submit_task(std::function<void()> task)
+    void submit_task(std::function<void()> task,
+                     TaskPriority priority = TaskPriority::Normal)
     {
-        thread_pool_.submit(std::move(task));
+        thread_pool_.submit(std::move(task), priority);
     }
 
     // Health check utilities
@@ -466,102 +634,463 @@ public:
         return "healthy";
     }
 
-    // Register a handler for one message type T
+    // Register a handler for one message type T. 'priority' selects the
+    // ThreadPool lane; use TaskPriority::High for control-plane messages
+    // (health checks) so they are not queued behind data-plane bursts.
     template <typename T>
     void register_message(MessageRouting routing,
-                          std::function<void(const T &)> handler)
+                          std::function<void(const T &)> handler,
+                          TaskPriority priority = TaskPriority::Normal)
+    {
+        register_message<T>(routing, std::move(handler), std::function<std::string(const T &)>(), priority);
+    }
+
+#if SERVICE_COROUTINES
+    // Register a coroutine handler (returns CoTask<void>). It may co_await
+    // the pool, resume_after() timers and request_async() replies; while it
+    // waits no worker is held, so many messages can be in flight on a few
+    // threads. It starts on a pool worker and owns a copy of the message
+    // until it finishes; exceptions are logged. Unordered only: a per-key
+    // strand would be released at the handler's first suspension.
+    template <typename T, typename Handler,
+              std::enable_if_t<std::is_same_v<std::invoke_result_t<Handler &, const T &>, CoTask<void>>, int> = 0>
+    void register_message(MessageRouting routing,
+                          Handler handler,
+                          TaskPriority priority = TaskPriority::Normal)
+    {
+        register_message<T>(routing,
+                            std::function<void(const T &)>(
+                                [this, handler = std::move(handler)](const T &msg)
+                                {
+                                    co_detach(run_coroutine_handler<T>(handler, msg, logger_,
+                                                                       T::descriptor()->full_name()));
+                                }),
+                            priority);
+    }
+#endif
+
+    // Register a handler whose messages are ordered per key: handlers for
+    // messages with the same key_extractor() result run one at a time in
+    // arrival order, different keys run in parallel (e.g. key by account_id).
+    // An empty key_extractor gives the unordered behaviour above.
+    template <typename T>
+    void register_message(MessageRouting routing,
+                          std::function<void(const T &)> handler,
+                          std::function<std::string(const T &)> key_extractor,
+                          TaskPriority priority = TaskPriority::Normal)
     {
         const std::string type_name = T::descriptor()->full_name();
 
         logger_->info("Registering handler for message type: {}, routing: {}",
                       type_name,
-                      routing == MessageRouting::Broadcast ? "Broadcast" : "PointToPoint");
+                      routing_name(routing));
 
-        handlers_[type_name] = [this, handler, type_name](const std::string &raw)
+        // Unordered handlers run inside the receive job on a pool worker:
+        // the message is parsed there into the worker's arena and passed by
+        // reference, with no second hop and no copy. Keyed handlers parse on
+        // the receiving thread (see receive_message) so keys are taken in
+        // arrival order; the message is moved into its strand.
+        handlers_[type_name].priority = priority;
+        handlers_[type_name].inline_dispatch = static_cast<bool>(key_extractor);
+        handlers_[type_name].admission_key = admission_key(type_name);
+        handlers_[type_name].handler = [this, handler, key_extractor, type_name,
+                                        priority](const MessageBuffer &raw, ThreadPool::Deadline)
         {
-            auto request_logger = create_request_logger();
-            request_logger->debug("Processing message: {}, size: {} bytes", type_name, raw.size());
+            const RequestContext context = create_request_context();
+            context.debug("Processing message: {}, size: {} bytes", type_name, raw.size());
+            auto start_time = std::chrono::high_resolution_clock::now();
 
-            T msg;
-            if (!msg.ParseFromString(raw))
+            if (!key_extractor)
             {
-                request_logger->error("Failed to parse message: {}", type_name);
+                service_host_detail::ParseArena::Scope scope;
+                T *msg = google::protobuf::Arena::CreateMessage<T>(&scope.arena());
+                if (!msg->ParseFromArray(raw.data(), static_cast<int>(raw.size())))
+                {
+                    context.error("Failed to parse message: {}", type_name);
+                    return;
+                }
+                // The pool already dropped the job if the header deadline
+                // passed; the message's own deadline is only known now
+                if constexpr (service_host_detail::has_trace_metadata<T>::value)
+                {
+                    if (deadlines_enabled_ &&
+                        std::chrono::steady_clock::now() > service_host_detail::deadline_from_unix_ms(
+                                                               msg->trace_metadata().deadline_unix_ms()))
+                    {
+                        expired_messages_.fetch_add(1, std::memory_order_relaxed);
+                        context.debug("Dropping expired message: {}", type_name);
+                        return;
+                    }
+                }
+                run_handler(handler, *msg, context, type_name, start_time);
                 return;
             }
 
-            auto start_time = std::chrono::high_resolution_clock::now();
+            T msg;
+            if (!msg.ParseFromArray(raw.data(), static_cast<int>(raw.size())))
+            {
+                context.error("Failed to parse message: {}", type_name);
+                return;
+            }
+            std::string key = key_extractor(msg);
 
-            // Submit to thread pool with logging
-            thread_pool_.submit([handler, msg, request_logger, type_name, start_time]()
-                                {
-                request_logger->trace("Handler execution started for: {}", type_name);
-                
-                try {
-                    handler(msg);
-                    
-                    auto end_time = std::chrono::high_resolution_clock::now();
-                    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
-                        end_time - start_time).count();
-                    
-                    request_logger->debug("Handler completed for: {}, duration: {}μs", 
-                                        type_name, duration);
-                } catch (const std::exception& e) {
-                    request_logger->error("Handler failed for: {}, error: {}", type_name, e.what());
-                } catch (...) {
-                    request_logger->error("Handler failed for: {} with unknown exception", type_name);
-                } });
+            // msg is moved, not copied; the closure fits InlineTask's buffer
+            keyed_executor_.submit(key, [handler, msg = std::move(msg), context, type_name, start_time]()
+                                   { run_handler(handler, msg, context, type_name, start_time); },
+                                   priority);
         };
 
-        if (routing == MessageRouting::Broadcast)
+        if (conn_)
+        {
+            subscribe_V2(routing, type_name);  // Use V2 with tracing
+        }
+
+        logger_->info("Successfully registered handler for: {}", type_name);
+    }
+
+    // Register a request handler: the Resp it returns for each Req is sent
+    // to the request's reply subject, which is how request<Req, Resp>() (or
+    // any NATS requester) gets its answer. A Req published without a reply
+    // subject hands its Resp to 'no_reply' instead, if given, and is
+    // otherwise answered by nobody. A handler that throws sends nothing and
+    // the requester times out. Unordered, like register_message.
+    template <typename Req, typename Resp>
+    void register_request_handler(MessageRouting routing,
+                                  std::function<Resp(const Req &)> handler,
+                                  TaskPriority priority = TaskPriority::Normal,
+                                  std::function<void(const Req &, const Resp &)> no_reply = {})
+    {
+        const std::string type_name = Req::descriptor()->full_name();
+
+        logger_->info("Registering request handler for message type: {}, routing: {}, response: {}",
+                      type_name,
+                      routing_name(routing),
+                      Resp::descriptor()->full_name());
+
+        RegisteredHandler &entry = handlers_[type_name];
+        entry.priority = priority;
+        entry.inline_dispatch = false;
+        entry.admission_key = admission_key(type_name);
+        entry.handler = [this, handler, no_reply, type_name](const MessageBuffer &raw, ThreadPool::Deadline)
         {
-            if (conn_)
+            const RequestContext context = create_request_context();
+            auto start_time = std::chrono::high_resolution_clock::now();
+
+            service_host_detail::ParseArena::Scope scope;
+            Req *msg = google::protobuf::Arena::CreateMessage<Req>(&scope.arena());
+            if (!msg->ParseFromArray(raw.data(), static_cast<int>(raw.size())))
             {
-                subscribe_broadcast_V2(type_name);  // Use V2 with tracing
+                context.error("Failed to parse message: {}", type_name);
+                return;
             }
-        }
-        else
+
+            const std::function<void(const Req &)> respond = [&](const Req &req)
+            {
+                Resp response = handler(req);
+                if (!raw.reply().empty())
+                    send_reply(std::string(raw.reply()), response);
+                else if (no_reply)
+                    no_reply(req, response);
+                else
+                    context.warn("No reply subject on {}, response dropped", type_name);
+            };
+            run_handler(respond, *msg, context, type_name, start_time);
+        };
+
+        if (conn_)
+            subscribe_V2(routing, type_name);
+
+        logger_->info("Successfully registered request handler for: {}", type_name);
+    }
+
+    // Register a conflating handler: like the keyed register_message,
+    // messages with the same key_extractor() result run one at a time, but
+    // a key keeps only its latest unprocessed message. One that arrives
+    // while an older one for its key is still queued replaces it, so a
+    // handler that falls behind skips stale updates (e.g. MarketDataUpdate
+    // keyed by symbol). Replaced messages are counted in
+    // servicehost_messages_conflated_total.
+    template <typename T>
+    void register_conflated_message(MessageRouting routing,
+                                    std::function<void(const T &)> handler,
+                                    std::function<std::string(const T &)> key_extractor,
+                                    TaskPriority priority = TaskPriority::Normal)
+    {
+        const std::string type_name = T::descriptor()->full_name();
+
+        logger_->info("Registering conflating handler for message type: {}, routing: {}",
+                      type_name,
+                      routing_name(routing));
+
+        RegisteredHandler &entry = handlers_[type_name];
+        entry.priority = priority;
+        entry.inline_dispatch = true;
+        entry.admission_key = admission_key(type_name);
+        entry.handler = [this, handler, key_extractor, type_name,
+                         priority](const MessageBuffer &raw, ThreadPool::Deadline)
         {
-            if (conn_)
+            const RequestContext context = create_request_context();
+            auto start_time = std::chrono::high_resolution_clock::now();
+
+            T msg;
+            if (!msg.ParseFromArray(raw.data(), static_cast<int>(raw.size())))
             {
-                subscribe_point_to_point_V2(type_name);  // Use V2 with tracing
+                context.error("Failed to parse message: {}", type_name);
+                return;
             }
-        }
+            std::string key = key_extractor(msg);
 
-        logger_->info("Successfully registered handler for: {}", type_name);
+            conflating_inbox_.submit(key, [handler, msg = std::move(msg), context, type_name, start_time]()
+                                     { run_handler(handler, msg, context, type_name, start_time); },
+                                     priority);
+        };
+
+        if (conn_)
+            subscribe_V2(routing, type_name);
+
+        logger_->info("Successfully registered conflating handler for: {}", type_name);
     }
 
-    // Dispatch incoming raw payload to the correct handler with tracing
+    // Consume T from a durable JetStream pull consumer instead of core NATS
+    // push: messages are fetched in batches of options.fetch_batch, run on
+    // the pool and acked only after the handler returns; a handler that
+    // throws gets its message redelivered. Fetching pauses while
+    // max_in_flight messages are unacked (see JetStreamConsumer). A message
+    // that does not parse is acked and dropped, since it never will parse.
+    // Needs StartService with JetStream enabled; returns false otherwise.
+    template <typename T>
+    bool register_jetstream_message(JetStreamConsumer::Options options,
+                                    std::function<void(const T &)> handler,
+                                    TaskPriority priority = TaskPriority::Normal)
+    {
+        const std::string type_name = T::descriptor()->full_name();
+        if (options.subject.empty())
+            options.subject = "system.broadcast." + type_name;
+
+        logger_->info("Registering JetStream handler for message type: {}, subject: {}, durable: {}",
+                      type_name, options.subject, options.durable);
+
+        auto consumer = std::make_unique<JetStreamConsumer>(
+            js_, thread_pool_, std::move(options),
+            [this, handler, type_name](const MessageBuffer &raw)
+            {
+                const RequestContext context = create_request_context();
+                auto start_time = std::chrono::high_resolution_clock::now();
+
+                service_host_detail::ParseArena::Scope scope;
+                T *msg = google::protobuf::Arena::CreateMessage<T>(&scope.arena());
+                if (!msg->ParseFromArray(raw.data(), static_cast<int>(raw.size())))
+                {
+                    context.error("Failed to parse message: {}", type_name);
+                    return true;
+                }
+                handler(*msg);  // Exceptions nak the message
+                context.debug("JetStream handler completed for: {}, duration: {}μs", type_name,
+                              std::chrono::duration_cast<std::chrono::microseconds>(
+                                  std::chrono::high_resolution_clock::now() - start_time)
+                                  .count());
+                return true;
+            },
+            logger_, priority);
+
+        if (!consumer->start())
+            return false;
+        jetstream_consumers_.push_back(std::move(consumer));
+        return true;
+    }
+
+    // Register a batch handler for a high-rate message type T. Messages are
+    // collected on the receiving thread and handed to one worker at a time:
+    // max_batch of them, or fewer once max_delay has passed since the
+    // first. The handler gets the batch parsed, in arrival order; logging
+    // and metrics are per batch. One recurring scheduler task per type
+    // checks every max_delay / 2 for an overdue partial batch, so one may
+    // wait up to 1.5 x max_delay; without the scheduler running it waits
+    // for the next message. shutdown() flushes what is left. Keys and
+    // deadlines do not apply. A batch the pool refuses (full under Reject,
+    // or shut down) is lost whole; its messages are counted in
+    // servicehost_batch_messages_dropped_total.
+    template <typename T>
+    void register_batch_message(MessageRouting routing,
+                                size_t max_batch,
+                                std::chrono::milliseconds max_delay,
+                                std::function<void(BatchView<T>)> handler,
+                                TaskPriority priority = TaskPriority::Normal)
+    {
+        const std::string type_name = T::descriptor()->full_name();
+
+        logger_->info("Registering batch handler for message type: {}, routing: {}, max_batch: {}, max_delay: {}ms",
+                      type_name,
+                      routing_name(routing),
+                      max_batch, max_delay.count());
+
+        auto batcher = std::make_shared<MessageBatcher>(
+            max_batch, max_delay,
+            [this, handler, type_name, priority](MessageBatcher::Batch &&batch)
+            {
+                const size_t size = batch.size();
+                if (!thread_pool_.submit([this, handler, type_name, batch = std::move(batch)]()
+                                         { run_batch_handler<T>(handler, batch, type_name); },
+                                         priority))
+                {
+                    dropped_batch_messages_.fetch_add(size, std::memory_order_relaxed);
+                    logger_->warn("Thread pool refused batch of {} {} messages (queue full or shutting down)",
+                                  size, type_name);
+                }
+            });
+
+        // Not a timer per batch: that would put a scheduler insert and wake
+        // back on the path of every partial batch
+        auto config = ServiceScheduler::TaskConfig::create_default();
+        config.priority = priority;
+        std::weak_ptr<MessageBatcher> weak_batcher = batcher;
+        scheduler_->schedule_interval(
+            "batch_flush." + type_name,
+            std::max(std::chrono::milliseconds(1), max_delay / 2),
+            [weak_batcher]()
+            {
+                if (auto batcher = weak_batcher.lock())
+                    batcher->flush_if_due();
+            },
+            config);
+
+        RegisteredHandler &entry = handlers_[type_name];
+        entry.priority = priority;
+        entry.inline_dispatch = true;
+        entry.admission_key = admission_key(type_name);
+        entry.handler = [batcher](const MessageBuffer &raw, ThreadPool::Deadline)
+        { batcher->add(raw); };
+        entry.flush = [batcher]()
+        { batcher->flush(); };
+
+        if (conn_)
+            subscribe_V2(routing, type_name);
+
+        logger_->info("Successfully registered batch handler for: {}", type_name);
+    }
+
+    // Dispatch incoming raw payload to the correct handler with tracing.
+    // Work still queued when 'deadline' passes is dropped and counted in
+    // expired_tasks(); the message's TraceMetadata.deadline_unix_ms, if set,
+    // is checked once it is parsed. Keyed handlers ignore deadlines: dropping
+    // one message of a strand would break its ordering guarantee.
+    // The payload is shared, not copied, down to ParseFromArray(); a
+    // MessageBuffer::adopt()ed natsMsg is destroyed once it is parsed.
     void receive_message(const std::string &type_name,
-                         const std::string &payload)
+                         MessageBuffer payload,
+                         ThreadPool::Deadline deadline = ThreadPool::kNoDeadline)
     {
         auto it = handlers_.find(type_name);
         if (it != handlers_.end())
+            dispatch(it->first, it->second, std::move(payload), deadline);
+        else
+            logger_->warn("No handler registered for message type: {}", type_name);
+    }
+
+    // Copying overload for payloads that did not come from NATS
+    void receive_message(const std::string &type_name,
+                         const std::string &payload,
+                         ThreadPool::Deadline deadline = ThreadPool::kNoDeadline)
+    {
+        receive_message(type_name, MessageBuffer::copy_of(payload), deadline);
+    }
+
+    // Call a typed handler, logging its duration and any exception
+    template <typename T>
+    static void run_handler(const std::function<void(const T &)> &handler, const T &msg,
+                            const RequestContext &logger,
+                            const std::string &type_name,
+                            std::chrono::high_resolution_clock::time_point start_time)
+    {
+        logger.trace("Handler execution started for: {}", type_name);
+        try
         {
-            // Offload to thread pool for parallel processing with tracing
-            thread_pool_.submit([handler = it->second, payload, type_name, this]()
-                                {
-                // Start receive span
-                TRACE_SPAN("ServiceHost::receive_message");
-                _trace_span.add_attributes({
-                    {"messaging.operation", "receive"},
-                    {"messaging.destination", type_name},
-                    {"service.name", service_name_},
-                    {"service.instance.id", uid_}
-                });
-
-                auto [trace_id, span_id] = _trace_span.get_trace_and_span_ids();
-                std::ostringstream thread_id_stream;
-                thread_id_stream << std::this_thread::get_id();
-                logger_->debug("Processing {} in worker thread {} trace_id={} span_id={}", type_name, thread_id_stream.str(), trace_id, span_id);
-                handler(payload);
-            });
+            handler(msg);
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::high_resolution_clock::now() - start_time)
+                                .count();
+            logger.debug("Handler completed for: {}, duration: {}μs", type_name, duration);
         }
-        else
+        catch (const std::exception &e)
         {
-            logger_->warn("No handler registered for message type: {}", type_name);
+            logger.error("Handler failed for: {}, error: {}", type_name, e.what());
+        }
+        catch (...)
+        {
+            logger.error("Handler failed for: {} with unknown exception", type_name);
         }
     }
 
+    // Parse one batch and call its handler once. Messages are parsed into a
+    // per-thread vector<T> reused across batches (parsing into a cleared
+    // message keeps its string and repeated-field capacity); a batch run
+    // inline inside another on the same thread just gets a fresh vector.
+    template <typename T>
+    void run_batch_handler(const std::function<void(BatchView<T>)> &handler,
+                           const MessageBatcher::Batch &batch, const std::string &type_name)
+    {
+        thread_local std::vector<T> cache;
+        std::vector<T> parsed = std::move(cache);
+        if (parsed.size() < batch.size())
+            parsed.resize(batch.size());
+
+        size_t count = 0;
+        for (const MessageBuffer &raw : batch)
+        {
+            if (parsed[count].ParseFromArray(raw.data(), static_cast<int>(raw.size())))
+                ++count;
+            else
+                logger_->error("Failed to parse message: {}", type_name);
+        }
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+        try
+        {
+            handler(BatchView<T>(parsed.data(), count));
+        }
+        catch (const std::exception &e)
+        {
+            logger_->error("Batch handler failed for: {}, error: {}", type_name, e.what());
+        }
+        catch (...)
+        {
+            logger_->error("Batch handler failed for: {} with unknown exception", type_name);
+        }
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - start_time);
+
+        if (messages_received_total_)
+            messages_received_total_->inc(static_cast<double>(count));
+        if (message_handler_duration_)
+            message_handler_duration_->observe(duration.count() / 1000000.0);
+        logger_->debug("Batch handler completed for: {}, messages: {}, duration: {}μs",
+                       type_name, count, duration.count());
+
+        cache = std::move(parsed);
+    }
+
+#if SERVICE_COROUTINES
+    // Frame for one coroutine handler call; parameters are copied into it,
+    // so the message outlives the receive job that started it
+    template <typename T, typename Handler>
+    static CoTask<void> run_coroutine_handler(Handler handler, T msg, std::shared_ptr<Logger> logger,
+                                              std::string type_name)
+    {
+        try
+        {
+            co_await handler(msg);
+        }
+        catch (const std::exception &e)
+        {
+            logger->error("Coroutine handler failed for: {}, error: {}", type_name, e.what());
+        }
+        catch (...)
+        {
+            logger->error("Coroutine handler failed for: {} with unknown exception", type_name);
+        }
+    }
+#endif
+
     // Helper to extract trace context from protobuf message
     template <typename T>
     std::unordered_map<std::string, std::string> extract_trace_context_from_message(const T &message)
@@ -630,6 +1159,77 @@ private:
     // V2 methods with OpenTelemetry trace context support
     void subscribe_broadcast_V2(const std::string &type_name);
     void subscribe_point_to_point_V2(const std::string &type_name);
+    void subscribe_queue_group_V2(const std::string &type_name);
+    void subscribe_V2(MessageRouting routing, const std::string &type_name);
+
+    // Send a request through the shared reply inbox (created on first use);
+    // 'done' runs once with the reply or an error, possibly before return
+    void send_request(const std::string &subject, const std::string &payload,
+                      std::chrono::milliseconds timeout, ReplyInbox::Completion done);
+    // Publish a register_request_handler response to its reply subject
+    void send_reply(const std::string &reply_subject, const google::protobuf::Message &response);
+
+    // Build ThreadPool options from the "threads" and "threads.*" config keys
+    static ThreadPool::Options thread_pool_options(const Configuration &config)
+    {
+        ThreadPool::Options options;
+        options.threads = config.get<size_t>("threads", std::thread::hardware_concurrency());
+        const std::string backend = config.get<std::string>("threads.queue_backend", "shared");
+        if (backend == "work_stealing")
+            options.mode = ThreadPool::SchedulingMode::WorkStealing;
+        else if (backend == "ring")
+            options.mode = ThreadPool::SchedulingMode::LockFreeRing;
+        else
+            options.mode = ThreadPool::SchedulingMode::SharedQueue;
+        options.ring_capacity = config.get<size_t>("threads.ring_capacity", options.ring_capacity);
+        options.lane_policy = config.get<std::string>("threads.lane_policy", "strict") == "weighted"
+                                  ? ThreadPool::LanePolicy::Weighted
+                                  : ThreadPool::LanePolicy::Strict;
+        options.high_priority_weight = config.get<size_t>("threads.high_priority_weight",
+                                                          options.high_priority_weight);
+        options.cpu_list = CpuTopology::parse_cpu_list(config.get<std::string>("threads.cpu_list", ""));
+        options.numa_aware = config.get<std::string>("threads.numa_layout", "none") == "per_node";
+
+        options.capacity = config.get<size_t>("threads.queue_capacity", 0);
+        const std::string overflow = config.get<std::string>("threads.overflow_policy", "block");
+        if (overflow == "reject")
+            options.overflow = ThreadPool::OverflowPolicy::Reject;
+        else if (overflow == "drop_oldest")
+            options.overflow = ThreadPool::OverflowPolicy::DropOldest;
+        else if (overflow == "drop_newest_by_key")
+            options.overflow = ThreadPool::OverflowPolicy::DropNewestByKey;
+        else
+            options.overflow = ThreadPool::OverflowPolicy::Block;
+
+        // Elastic sizing: "threads" is the starting size within [min, max]
+        options.elastic = config.get<std::string>("threads.elastic", "false") == "true";
+        options.min_threads = config.get<size_t>("threads.min", options.min_threads);
+        options.max_threads = config.get<size_t>("threads.max", options.max_threads);
+        options.grow_wait = std::chrono::microseconds(
+            config.get<int64_t>("threads.grow_wait_us", options.grow_wait.count()));
+        options.shrink_wait = std::chrono::microseconds(
+            config.get<int64_t>("threads.shrink_wait_us", options.shrink_wait.count()));
+
+        // Idle strategy: spin, then yield, then park (all zero = park at once)
+        options.idle_spin = std::chrono::microseconds(config.get<int64_t>("threads.idle_spin_us", 0));
+        options.idle_yield = std::chrono::microseconds(config.get<int64_t>("threads.idle_yield_us", 0));
+
+        options.record_timings = config.get<std::string>("threads.task_timings", "true") == "true";
+        return options;
+    }
+
+    // Non-zero ThreadPool key for one message type: under DropNewestByKey a
+    // new message replaces the newest queued message of the same type
+    static size_t admission_key(const std::string &type_name)
+    {
+        return std::hash<std::string>{}(type_name) | 1;
+    }
+
+    // Log each worker's NUMA node, affinity mask and current CPU
+    void log_thread_pool_placement() const;
+
+    // Deadline from the "Deadline" NATS header (Unix epoch ms), if enabled
+    ThreadPool::Deadline message_deadline(natsMsg *msg) const;
 
     std::string uid_;
     std::string service_name_;
@@ -638,13 +1238,56 @@ private:
     jsCtx *js_ = nullptr;
     natsStatus status_;
 
-    using HandlerFunc = std::function<void(const std::string &)>;
-    std::unordered_map<std::string, HandlerFunc> handlers_;
+    using HandlerFunc = std::function<void(const MessageBuffer &payload, ThreadPool::Deadline deadline)>;
+    struct RegisteredHandler
+    {
+        HandlerFunc handler;
+        TaskPriority priority = TaskPriority::Normal; // ThreadPool lane for this message type
+        bool inline_dispatch = false;                  // Keyed or batch: handler runs on the receiving thread
+        size_t admission_key = 0;                      // DropNewestByKey key for this message type
+        std::function<void()> flush{};                 // Batch: dispatch the partial batch
+    };
+    std::unordered_map<std::string, RegisteredHandler> handlers_;
+
+    // Closure of one NATS subscription, bound when it is created to the
+    // handler it serves so delivery needs no subject parsing or lookup.
+    // Points into handlers_, whose nodes never move; owned for the host's
+    // lifetime since the NATS client holds the raw pointer.
+    struct SubscriptionSlot
+    {
+        ServiceHost *host;
+        const std::string *type_name; // Key of 'entry' in handlers_
+        const RegisteredHandler *entry;
+        MessageRouting routing;
+        std::atomic<size_t> delivered{0}; // Messages NATS handed to this instance
+        std::shared_ptr<PrometheusMetrics::Counter> delivered_total{}; // Created on first export
+        size_t exported = 0;
+    };
+    std::vector<std::unique_ptr<SubscriptionSlot>> subscriptions_;
+    mutable std::mutex subscriptions_mutex_; // Guards subscriptions_ (metrics export reads it)
+
+    // Slot for the registered handler of 'type_name'; nullptr (logged) if
+    // none is registered, in which case the caller must not subscribe
+    SubscriptionSlot *bind_subscription(const std::string &type_name, MessageRouting routing);
+    // NATS callback for the V2 (traced) subscriptions
+    static void deliver_traced(natsConnection *, natsSubscription *, natsMsg *msg, void *closure);
+    // NATS callback for register_handler() subscriptions
+    static void deliver_raw(natsConnection *, natsSubscription *, natsMsg *msg, void *closure);
+    // Run 'entry' for one message: inline for keyed, conflating and batch handlers, else on the pool
+    void dispatch(const std::string &type_name, const RegisteredHandler &entry,
+                  MessageBuffer payload, ThreadPool::Deadline deadline = ThreadPool::kNoDeadline);
 
     Configuration config_;           // Configuration for service settings
     ThreadPool thread_pool_;         // Thread pool for parallel message processing
+    KeyedExecutor keyed_executor_{thread_pool_}; // Per-key ordering for keyed register_message
+    ConflatingInbox conflating_inbox_{thread_pool_}; // Latest-per-key for register_conflated_message
+    std::vector<std::unique_ptr<JetStreamConsumer>> jetstream_consumers_; // register_jetstream_message
+    std::mutex reply_inbox_mutex_;
+    std::unique_ptr<ReplyInbox> reply_inbox_;  // request(), request_async(); created on first use
+    bool deadlines_enabled_ = config_.get<std::string>("threads.deadlines", "true") == "true";
+    std::atomic<size_t> expired_messages_{0}; // Parsed messages past their TraceMetadata deadline
+    std::atomic<size_t> dropped_batch_messages_{0}; // Messages in batches the pool refused
     std::shared_ptr<Logger> logger_; // Structured logging with correlation IDs
-    std::mutex publish_mutex_;       // Ensure thread-safe publishing
     std::unique_ptr<ServiceCache> cache_; // Integrated LRU caching system
     std::unique_ptr<ServiceScheduler> scheduler_; // Integrated task scheduler
 
@@ -697,6 +1340,30 @@ private:
     std::shared_ptr<PrometheusMetrics::Gauge> active_connections_;
     std::shared_ptr<PrometheusMetrics::Gauge> thread_pool_active_threads_;
     std::shared_ptr<PrometheusMetrics::Gauge> thread_pool_queue_size_;
+    std::shared_ptr<PrometheusMetrics::Gauge> thread_pool_heap_spilled_tasks_;
+    std::shared_ptr<PrometheusMetrics::Histogram> thread_pool_task_wait_;  // Per-task timings
+    std::shared_ptr<PrometheusMetrics::Histogram> thread_pool_task_run_;
+    std::vector<std::shared_ptr<PrometheusMetrics::Gauge>> thread_pool_worker_cpu_;
+    std::shared_ptr<PrometheusMetrics::Counter> thread_pool_rejected_total_;
+    std::shared_ptr<PrometheusMetrics::Counter> thread_pool_dropped_total_;
+    std::shared_ptr<PrometheusMetrics::Counter> thread_pool_blocked_total_;
+    std::shared_ptr<PrometheusMetrics::Counter> thread_pool_expired_total_;
+    std::shared_ptr<PrometheusMetrics::Counter> messages_conflated_total_;
+    std::shared_ptr<PrometheusMetrics::Counter> batch_messages_dropped_total_;
+    size_t exported_rejected_ = 0;   // Pool counter values already added to the counters above
+    size_t exported_dropped_ = 0;
+    size_t exported_blocked_ = 0;
+    size_t exported_expired_ = 0;
+    size_t exported_conflated_ = 0;
+    size_t exported_batch_dropped_ = 0;
+    std::shared_ptr<PrometheusMetrics::Counter> thread_pool_grow_total_;    // Elastic resize decisions
+    std::shared_ptr<PrometheusMetrics::Counter> thread_pool_shrink_total_;
+    std::shared_ptr<PrometheusMetrics::Gauge> thread_pool_queue_wait_seconds_;
+    size_t exported_grows_ = 0;
+    size_t exported_shrinks_ = 0;
+    size_t backpressure_last_rejected_ = 0;  // Values seen by the previous backpressure check
+    size_t backpressure_last_dropped_ = 0;
+    size_t backpressure_last_blocked_ = 0;
     std::shared_ptr<PrometheusMetrics::Gauge> system_cpu_usage_;
     std::shared_ptr<PrometheusMetrics::Gauge> system_memory_usage_;
     std::shared_ptr<PrometheusMetrics::Counter> cache_hits_total_;
@@ -1,15 +1,40 @@
 #include "service_host.hpp"
 #include "messages.pb.h"
 #include <unordered_map>  // For trace context headers
-#include <future>         // For std::future, std::promise, std::async
 #include <thread>         // For std::thread
 #include <fstream>        // For system monitoring
 #include <sstream>        // For string stream operations
 #include <sys/resource.h> // For resource usage monitoring
+#include <stdexcept>      // For request_async failures
+#include <cstdlib>        // For std::strtoll (Deadline header)
 
 // Static instance for signal handler
 ServiceHost* ServiceHost::instance_ = nullptr;
 
+// ThreadPool timing buckets exported to Prometheus: every other power of
+// two from ~1us (2^10 ns) to ~1s (2^30 ns)
+static std::vector<size_t> exported_timing_buckets() {
+    std::vector<size_t> buckets;
+    for (size_t bucket = 10; bucket <= 30; bucket += 2) {
+        buckets.push_back(bucket);
+    }
+    return buckets;
+}
+
+static void export_timing_histogram(PrometheusMetrics::Histogram& histogram,
+                                    const ThreadPool::TimingHistogram& timings) {
+    std::vector<uint64_t> cumulative;
+    uint64_t below = 0;
+    size_t next = 0;
+    for (size_t bucket : exported_timing_buckets()) {
+        for (; next <= bucket; ++next) {
+            below += timings.buckets[next];
+        }
+        cumulative.push_back(below);
+    }
+    histogram.set_snapshot(cumulative, timings.count, timings.sum_ns / 1e9);
+}
+
 // Signal handler for graceful shutdown
 static void signal_handler(int signal) {
     std::cout << "\n🛑 Received signal " << signal << ", initiating graceful shutdown..." << std::endl;
@@ -44,6 +69,28 @@ void ServiceHost::shutdown() {
         std::cerr << "⚠️ Error stopping config watcher: " << e.what() << std::endl;
     }
     
+    // Stop JetStream fetching and let in-flight messages be acked
+    for (auto& consumer : jetstream_consumers_) {
+        consumer->stop();
+    }
+    
+    // Fail outstanding requests while their continuations can still run
+    ReplyInbox *reply_inbox = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(reply_inbox_mutex_);
+        reply_inbox = reply_inbox_.get();
+    }
+    if (reply_inbox) {
+        reply_inbox->close();
+    }
+    
+    // Hand partial batches to the pool while it still accepts work
+    for (auto& [type_name, entry] : handlers_) {
+        if (entry.flush) {
+            entry.flush();
+        }
+    }
+    
     // Shutdown thread pool (wait for current tasks to complete)
     thread_pool_.shutdown();
     std::cout << "✅ Thread pool shutdown completed" << std::endl;
@@ -172,27 +219,54 @@ void ServiceHost::publish_point_to_point(const std::string &target_uid, const go
     (this->*publish_point_to_point_impl_)(target_uid, message);
 }
 
+// Per-thread publish scratch: every publish on a thread serializes into the
+// same payload buffer and builds its subject in the same string, so once
+// both have grown to fit the thread's largest message a publish allocates
+// nothing. The NATS connection is thread-safe, so publishing threads share
+// no lock; natsConnection_Publish copies the bytes before returning.
+namespace {
+
+struct PublishScratch {
+    std::string payload;
+    std::string subject;
+    size_t size = 0;  // Bytes of 'payload' holding the current message
+
+    bool serialize(const google::protobuf::Message &message) {
+        size = message.ByteSizeLong();
+        if (payload.size() < size) {
+            payload.resize(size);
+        }
+        return message.SerializeToArray(payload.data(), static_cast<int>(size));
+    }
+};
+
+PublishScratch &publish_scratch() {
+    thread_local PublishScratch scratch;
+    return scratch;
+}
+
+} // namespace
+
 // Non-traced implementation (maximum performance)
 void ServiceHost::publish_broadcast_fast(const google::protobuf::Message &message) {
     // Metrics timing
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    std::lock_guard<std::mutex> lock(publish_mutex_);
-    
     if (!conn_) {
         std::cerr << "❌ NATS connection not initialized" << std::endl;
         return;
     }
 
-    std::string type_name = message.GetTypeName();
-    std::string data;
-    if (!message.SerializeToString(&data)) {
+    const std::string &type_name = message.GetDescriptor()->full_name();
+    PublishScratch &scratch = publish_scratch();
+    if (!scratch.serialize(message)) {
         std::cerr << "❌ Failed to serialize message of type: " << type_name << std::endl;
         return;
     }
 
-    std::string subject = "broadcast." + type_name;
-    natsStatus status = natsConnection_Publish(conn_, subject.c_str(), data.c_str(), data.length());
+    scratch.subject.assign("broadcast.").append(type_name);
+    natsStatus status = natsConnection_Publish(conn_, scratch.subject.c_str(), scratch.payload.data(),
+                                               static_cast<int>(scratch.size));
     if (status != NATS_OK) {
         std::cerr << "❌ Failed to publish broadcast message: " << natsStatus_GetText(status) << std::endl;
     } else {
@@ -213,22 +287,21 @@ void ServiceHost::publish_point_to_point_fast(const std::string &target_uid, con
     // Metrics timing
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    std::lock_guard<std::mutex> lock(publish_mutex_);
-    
     if (!conn_) {
         std::cerr << "❌ NATS connection not initialized" << std::endl;
         return;
     }
 
-    std::string type_name = message.GetTypeName();
-    std::string data;
-    if (!message.SerializeToString(&data)) {
+    const std::string &type_name = message.GetDescriptor()->full_name();
+    PublishScratch &scratch = publish_scratch();
+    if (!scratch.serialize(message)) {
         std::cerr << "❌ Failed to serialize message of type: " << type_name << std::endl;
         return;
     }
 
-    std::string subject = "p2p." + target_uid + "." + type_name;
-    natsStatus status = natsConnection_Publish(conn_, subject.c_str(), data.c_str(), data.length());
+    scratch.subject.assign("p2p.").append(target_uid).append(1, '.').append(type_name);
+    natsStatus status = natsConnection_Publish(conn_, scratch.subject.c_str(), scratch.payload.data(),
+                                               static_cast<int>(scratch.size));
     if (status != NATS_OK) {
         std::cerr << "❌ Failed to publish p2p message: " << natsStatus_GetText(status) << std::endl;
     } else {
@@ -245,6 +318,67 @@ void ServiceHost::publish_point_to_point_fast(const std::string &target_uid, con
     }
 }
 
+TaskFuture<std::string> ServiceHost::request_async(const std::string &subject,
+                                                   const std::string &payload,
+                                                   std::chrono::milliseconds timeout) {
+    auto promise = std::make_shared<TaskPromise<std::string>>(&thread_pool_);
+    TaskFuture<std::string> reply = promise->get_future();
+    send_request(subject, payload, timeout, [promise, subject](const MessageBuffer &payload, const char *error) {
+        if (error) {
+            promise->set_exception(std::make_exception_ptr(
+                std::runtime_error("request to " + subject + " failed: " + error)));
+        } else {
+            promise->set_value(payload.data(), payload.size());
+        }
+    });
+    return reply;
+}
+
+// All requests share one ReplyInbox: one subscription for the life of the
+// connection instead of a subscribe/unsubscribe pair per call
+void ServiceHost::send_request(const std::string &subject, const std::string &payload,
+                               std::chrono::milliseconds timeout, ReplyInbox::Completion done) {
+    ReplyInbox *inbox = nullptr;
+    natsStatus status = NATS_CONNECTION_CLOSED;
+    {
+        std::lock_guard<std::mutex> lock(reply_inbox_mutex_);
+        if (!reply_inbox_ && conn_ && running_) {
+            auto created = std::make_unique<ReplyInbox>(conn_);
+            status = created->start();
+            if (status == NATS_OK) {
+                logger_->info("Reply inbox subscribed on {}.*", created->prefix());
+                reply_inbox_ = std::move(created);
+            }
+        }
+        inbox = reply_inbox_.get();
+    }
+    if (!inbox) {
+        done(MessageBuffer(), conn_ ? natsStatus_GetText(status) : "NATS connection not initialized");
+        return;
+    }
+
+    // The inbox completes 'done' on every path, failed publishes included
+    if (inbox->request(subject, payload, timeout, std::move(done)) == NATS_OK && messages_sent_total_) {
+        messages_sent_total_->inc();
+    }
+}
+
+void ServiceHost::send_reply(const std::string &reply_subject, const google::protobuf::Message &response) {
+    std::string data;
+    if (!response.SerializeToString(&data)) {
+        logger_->error("Failed to serialize response of type: {}", response.GetTypeName());
+        return;
+    }
+    natsStatus status = conn_ ? natsConnection_Publish(conn_, reply_subject.c_str(), data.data(),
+                                                       static_cast<int>(data.size()))
+                              : NATS_CONNECTION_CLOSED;
+    if (status != NATS_OK) {
+        logger_->error("Failed to send {} reply: {}", response.GetTypeName(), natsStatus_GetText(status));
+    } else if (messages_sent_total_) {
+        messages_sent_total_->inc();
+    }
+}
+
 // Traced implementation (with OpenTelemetry overhead)
 void ServiceHost::publish_broadcast_traced(const google::protobuf::Message &message) {
 #ifdef HAVE_OPENTELEMETRY
@@ -258,8 +392,6 @@ void ServiceHost::publish_broadcast_traced(const google::protobuf::Message &mess
     span->SetAttribute("service.uid", uid_);
 #endif
 
-    std::lock_guard<std::mutex> lock(publish_mutex_);
-    
     if (!conn_) {
         std::cerr << "❌ NATS connection not initialized" << std::endl;
 #ifdef HAVE_OPENTELEMETRY
@@ -269,9 +401,9 @@ void ServiceHost::publish_broadcast_traced(const google::protobuf::Message &mess
         return;
     }
 
-    std::string type_name = message.GetTypeName();
-    std::string data;
-    if (!message.SerializeToString(&data)) {
+    const std::string &type_name = message.GetDescriptor()->full_name();
+    PublishScratch &scratch = publish_scratch();
+    if (!scratch.serialize(message)) {
         std::cerr << "❌ Failed to serialize message of type: " << type_name << std::endl;
 #ifdef HAVE_OPENTELEMETRY
         span->SetStatus(opentelemetry::trace::StatusCode::kError, "Message serialization failed");
@@ -280,12 +412,12 @@ void ServiceHost::publish_broadcast_traced(const google::protobuf::Message &mess
         return;
     }
 
-    std::string subject = "broadcast." + type_name;
+    const std::string &subject = scratch.subject.assign("broadcast.").append(type_name);
 
 #ifdef HAVE_OPENTELEMETRY
     // Create NATS message with tracing headers
     natsMsg *natsmsg = nullptr;
-    natsStatus status = natsMsg_Create(&natsmsg, subject.c_str(), nullptr, data.c_str(), data.length());
+    natsStatus status = natsMsg_Create(&natsmsg, subject.c_str(), nullptr, scratch.payload.data(), static_cast<int>(scratch.size));
     
     if (status == NATS_OK) {
         // Inject trace context into NATS headers
@@ -323,7 +455,7 @@ void ServiceHost::publish_broadcast_traced(const google::protobuf::Message &mess
     span->End();
 #else
     // Simple NATS publish without tracing
-    natsStatus status = natsConnection_Publish(conn_, subject.c_str(), data.c_str(), data.length());
+    natsStatus status = natsConnection_Publish(conn_, subject.c_str(), scratch.payload.data(), static_cast<int>(scratch.size));
     if (status != NATS_OK) {
         std::cerr << "❌ Failed to publish broadcast message: " << natsStatus_GetText(status) << std::endl;
     }
@@ -343,8 +475,6 @@ void ServiceHost::publish_point_to_point_traced(const std::string &target_uid, c
     span->SetAttribute("service.uid", uid_);
 #endif
 
-    std::lock_guard<std::mutex> lock(publish_mutex_);
-    
     if (!conn_) {
         std::cerr << "❌ NATS connection not initialized" << std::endl;
 #ifdef HAVE_OPENTELEMETRY
@@ -354,9 +484,9 @@ void ServiceHost::publish_point_to_point_traced(const std::string &target_uid, c
         return;
     }
 
-    std::string type_name = message.GetTypeName();
-    std::string data;
-    if (!message.SerializeToString(&data)) {
+    const std::string &type_name = message.GetDescriptor()->full_name();
+    PublishScratch &scratch = publish_scratch();
+    if (!scratch.serialize(message)) {
         std::cerr << "❌ Failed to serialize message of type: " << type_name << std::endl;
 #ifdef HAVE_OPENTELEMETRY
         span->SetStatus(opentelemetry::trace::StatusCode::kError, "Message serialization failed");
@@ -365,12 +495,12 @@ void ServiceHost::publish_point_to_point_traced(const std::string &target_uid, c
         return;
     }
 
-    std::string subject = "p2p." + target_uid + "." + type_name;
+    const std::string &subject = scratch.subject.assign("p2p.").append(target_uid).append(1, '.').append(type_name);
 
 #ifdef HAVE_OPENTELEMETRY
     // Create NATS message with tracing headers
     natsMsg *natsmsg = nullptr;
-    natsStatus status = natsMsg_Create(&natsmsg, subject.c_str(), nullptr, data.c_str(), data.length());
+    natsStatus status = natsMsg_Create(&natsmsg, subject.c_str(), nullptr, scratch.payload.data(), static_cast<int>(scratch.size));
     
     if (status == NATS_OK) {
         // Inject trace context into NATS headers
@@ -408,27 +538,58 @@ void ServiceHost::publish_point_to_point_traced(const std::string &target_uid, c
     span->End();
 #else
     // Simple NATS publish without tracing
-    natsStatus status = natsConnection_Publish(conn_, subject.c_str(), data.c_str(), data.length());
+    natsStatus status = natsConnection_Publish(conn_, subject.c_str(), scratch.payload.data(), static_cast<int>(scratch.size));
     if (status != NATS_OK) {
         std::cerr << "❌ Failed to publish p2p message: " << natsStatus_GetText(status) << std::endl;
     }
 #endif
 }
 
+ThreadPool::Deadline ServiceHost::message_deadline(natsMsg* msg) const {
+    if (!deadlines_enabled_)
+        return ThreadPool::kNoDeadline;
+    const char* value = nullptr;
+    if (natsMsgHeader_Get(msg, "Deadline", &value) != NATS_OK || !value)
+        return ThreadPool::kNoDeadline;
+    return service_host_detail::deadline_from_unix_ms(std::strtoll(value, nullptr, 10));
+}
+
+ServiceHost::SubscriptionSlot* ServiceHost::bind_subscription(const std::string& type_name,
+                                                               MessageRouting routing) {
+    auto it = handlers_.find(type_name);
+    if (it == handlers_.end()) {
+        logger_->error("No handler registered for {}; not subscribing", type_name);
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+    subscriptions_.emplace_back(new SubscriptionSlot{this, &it->first, &it->second, routing});
+    return subscriptions_.back().get();
+}
+
+size_t ServiceHost::delivered_messages(const std::string& type_name) const {
+    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+    size_t total = 0;
+    for (const auto& slot : subscriptions_) {
+        if (*slot->type_name == type_name) {
+            total += slot->delivered.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
 void ServiceHost::subscribe_broadcast(const std::string& type_name) {
+    SubscriptionSlot* slot = bind_subscription(type_name, MessageRouting::Broadcast);
+    if (!slot)
+        return;
     std::string subject = "system.broadcast." + type_name;
     natsSubscription* sub = nullptr;
 
     status_ = natsConnection_Subscribe(&sub, conn_, subject.c_str(),
       [](natsConnection*, natsSubscription*, natsMsg* msg, void* closure) {
-        auto* self = static_cast<ServiceHost*>(closure);
-        std::string subj(natsMsg_GetSubject(msg));
-        std::string payload(natsMsg_GetData(msg), natsMsg_GetDataLength(msg));
-        std::string prefix = "system.broadcast.";
-        std::string tn = subj.substr(prefix.size());
-        self->receive_message(tn, payload);
-        natsMsg_Destroy(msg);
-      }, this);
+        auto* slot = static_cast<SubscriptionSlot*>(closure);
+        slot->delivered.fetch_add(1, std::memory_order_relaxed);
+        slot->host->dispatch(*slot->type_name, *slot->entry, MessageBuffer::adopt(msg));
+      }, slot);
 
     if (status_ == NATS_OK)
         std::cout << "📡 Subscribed to broadcast: " << subject << std::endl;
@@ -438,21 +599,19 @@ void ServiceHost::subscribe_broadcast(const std::string& type_name) {
 }
 
 void ServiceHost::subscribe_point_to_point(const std::string& type_name) {
+    SubscriptionSlot* slot = bind_subscription(type_name, MessageRouting::PointToPoint);
+    if (!slot) {
+        return;
+    }
     const std::string subject = "system.direct." + uid_ + "." + type_name;
     natsSubscription* sub = nullptr;
 
     status_ = natsConnection_Subscribe(&sub, conn_, subject.c_str(),
         [](natsConnection*, natsSubscription*, natsMsg* msg, void* closure) {
-            auto* self = static_cast<ServiceHost*>(closure);
-            std::string subject_str = natsMsg_GetSubject(msg);
-            // Extract the full type name (including namespace) from subject
-            // Format: system.direct.svc-portfolio-001.Trevor.HealthCheckRequest
-            std::string prefix = "system.direct." + self->uid_ + ".";
-            std::string extracted_type_name = subject_str.substr(prefix.length());
-            std::string payload(natsMsg_GetData(msg), natsMsg_GetDataLength(msg));
-            self->receive_message(extracted_type_name, payload);
-            natsMsg_Destroy(msg);
-        }, this);
+            auto* slot = static_cast<SubscriptionSlot*>(closure);
+            slot->delivered.fetch_add(1, std::memory_order_relaxed);
+            slot->host->dispatch(*slot->type_name, *slot->entry, MessageBuffer::adopt(msg));
+        }, slot);
 
     if (status_ == NATS_OK) {
         std::cout << "📡 Subscribed to point-to-point: " << subject << std::endl;
@@ -461,48 +620,47 @@ void ServiceHost::subscribe_point_to_point(const std::string& type_name) {
     }
 }
 
+void ServiceHost::deliver_traced(natsConnection*, natsSubscription*, natsMsg* msg, void* closure) {
+    auto* slot = static_cast<SubscriptionSlot*>(closure);
+    ServiceHost* self = slot->host;
+    slot->delivered.fetch_add(1, std::memory_order_relaxed);
+
+    #ifdef HAVE_OPENTELEMETRY
+    // 1️⃣ Extract trace context from NATS headers
+    std::unordered_map<std::string, std::string> headers;
+    if (msg->hdr && msg->hdr->count > 0) {
+        for (int i = 0; i < msg->hdr->count; ++i) {
+            if (msg->hdr->keys[i] && msg->hdr->values[i]) {
+                headers[msg->hdr->keys[i]] = msg->hdr->values[i];
+            }
+        }
+    }
+    auto parent_context = OpenTelemetryIntegration::extract_trace_context(headers);
+
+    // 2️⃣ Start child span for receiving
+    auto span = OpenTelemetryIntegration::start_span(
+        "receive:" + *slot->type_name, parent_context);
+    #endif
+
+    // 3️⃣ Process the message
+    // The pool job owns msg from here; no payload copy is made
+    const ThreadPool::Deadline deadline = self->message_deadline(msg);
+    self->dispatch(*slot->type_name, *slot->entry, MessageBuffer::adopt(msg), deadline);
+
+    // 4️⃣ End span
+    #ifdef HAVE_OPENTELEMETRY
+    OpenTelemetryIntegration::end_span(span);
+    #endif
+}
+
 void ServiceHost::subscribe_broadcast_V2(const std::string& type_name) {
+    SubscriptionSlot* slot = bind_subscription(type_name, MessageRouting::Broadcast);
+    if (!slot)
+        return;
     std::string subject = "system.broadcast." + type_name;
     natsSubscription* sub = nullptr;
 
-    status_ = natsConnection_Subscribe(&sub, conn_, subject.c_str(),
-        [](natsConnection*, natsSubscription*, natsMsg* msg, void* closure) {
-            auto* self = static_cast<ServiceHost*>(closure);
-            
-            // 1️⃣ Extract trace context from NATS headers
-            std::unordered_map<std::string, std::string> headers;
-            #ifdef HAVE_OPENTELEMETRY
-            if (msg->hdr && msg->hdr->count > 0) {
-                for (int i = 0; i < msg->hdr->count; ++i) {
-                    if (msg->hdr->keys[i] && msg->hdr->values[i]) {
-                        headers[msg->hdr->keys[i]] = msg->hdr->values[i];
-                    }
-                }
-            }
-            auto parent_context = OpenTelemetryIntegration::extract_trace_context(headers);
-            #endif
-            
-            // 2️⃣ Start child span for receiving
-            std::string subj(natsMsg_GetSubject(msg));
-            std::string prefix = "system.broadcast.";
-            std::string type_name = subj.substr(prefix.size());
-            
-            #ifdef HAVE_OPENTELEMETRY
-            auto span = OpenTelemetryIntegration::start_span(
-                "receive:" + type_name, parent_context);
-            #endif
-            
-            // 3️⃣ Process the message
-            std::string payload(natsMsg_GetData(msg), natsMsg_GetDataLength(msg));
-            self->receive_message(type_name, payload);
-            
-            // 4️⃣ End span
-            #ifdef HAVE_OPENTELEMETRY
-            OpenTelemetryIntegration::end_span(span);
-            #endif
-            
-            natsMsg_Destroy(msg);
-        }, this);
+    status_ = natsConnection_Subscribe(&sub, conn_, subject.c_str(), &ServiceHost::deliver_traced, slot);
 
     if (status_ == NATS_OK)
         std::cout << "📡 Subscribed to broadcast V2 (with tracing): " << subject << std::endl;
@@ -512,47 +670,14 @@ void ServiceHost::subscribe_broadcast_V2(const std::string& type_name) {
 }
 
 void ServiceHost::subscribe_point_to_point_V2(const std::string& type_name) {
+    SubscriptionSlot* slot = bind_subscription(type_name, MessageRouting::PointToPoint);
+    if (!slot) {
+        return;
+    }
     const std::string subject = "system.direct." + uid_ + "." + type_name;
     natsSubscription* sub = nullptr;
 
-    status_ = natsConnection_Subscribe(&sub, conn_, subject.c_str(),
-        [](natsConnection*, natsSubscription*, natsMsg* msg, void* closure) {
-            auto* self = static_cast<ServiceHost*>(closure);
-            
-            // 1️⃣ Extract trace context from NATS headers
-            std::unordered_map<std::string, std::string> headers;
-            #ifdef HAVE_OPENTELEMETRY
-            if (msg->hdr && msg->hdr->count > 0) {
-                for (int i = 0; i < msg->hdr->count; ++i) {
-                    if (msg->hdr->keys[i] && msg->hdr->values[i]) {
-                        headers[msg->hdr->keys[i]] = msg->hdr->values[i];
-                    }
-                }
-            }
-            auto parent_context = OpenTelemetryIntegration::extract_trace_context(headers);
-            #endif
-            
-            // 2️⃣ Start child span for receiving
-            std::string subject_str = natsMsg_GetSubject(msg);
-            std::string prefix = "system.direct." + self->uid_ + ".";
-            std::string extracted_type_name = subject_str.substr(prefix.length());
-            
-            #ifdef HAVE_OPENTELEMETRY
-            auto span = OpenTelemetryIntegration::start_span(
-                "receive:" + extracted_type_name, parent_context);
-            #endif
-            
-            // 3️⃣ Process the message
-            std::string payload(natsMsg_GetData(msg), natsMsg_GetDataLength(msg));
-            self->receive_message(extracted_type_name, payload);
-            
-            // 4️⃣ End span
-            #ifdef HAVE_OPENTELEMETRY
-            OpenTelemetryIntegration::end_span(span);
-            #endif
-            
-            natsMsg_Destroy(msg);
-        }, this);
+    status_ = natsConnection_Subscribe(&sub, conn_, subject.c_str(), &ServiceHost::deliver_traced, slot);
 
     if (status_ == NATS_OK) {
         std::cout << "📡 Subscribed to point-to-point V2 (with tracing): " << subject << std::endl;
@@ -561,6 +686,70 @@ void ServiceHost::subscribe_point_to_point_V2(const std::string& type_name) {
     }
 }
 
+void ServiceHost::subscribe_queue_group_V2(const std::string& type_name) {
+    SubscriptionSlot* slot = bind_subscription(type_name, MessageRouting::QueueGroup);
+    if (!slot) {
+        return;
+    }
+    const std::string subject = "system.broadcast." + type_name;
+    std::string queue = config_.get<std::string>("nats.queue_group", "");
+    if (queue.empty()) {
+        queue = service_name_;
+    }
+    natsSubscription* sub = nullptr;
+
+    status_ = natsConnection_QueueSubscribe(&sub, conn_, subject.c_str(), queue.c_str(),
+                                            &ServiceHost::deliver_traced, slot);
+
+    if (status_ == NATS_OK) {
+        std::cout << "📡 Subscribed to queue group V2 (with tracing): " << subject
+                  << " [" << queue << "]" << std::endl;
+    } else {
+        std::cerr << "❌ Failed to subscribe queue group V2: " << natsStatus_GetText(status_) << std::endl;
+    }
+}
+
+void ServiceHost::subscribe_V2(MessageRouting routing, const std::string& type_name) {
+    switch (routing) {
+        case MessageRouting::Broadcast: subscribe_broadcast_V2(type_name); break;
+        case MessageRouting::PointToPoint: subscribe_point_to_point_V2(type_name); break;
+        case MessageRouting::QueueGroup: subscribe_queue_group_V2(type_name); break;
+    }
+}
+
+void ServiceHost::dispatch(const std::string& type_name, const RegisteredHandler& entry,
+                           MessageBuffer payload, ThreadPool::Deadline deadline) {
+    if (entry.inline_dispatch) {
+        // Keyed or conflating handler: parse and hand to its key in arrival order.
+        // Batch handler: append to the pending batch.
+        entry.handler(payload, ThreadPool::kNoDeadline);
+        return;
+    }
+
+    // Offload to thread pool for parallel processing with tracing. The
+    // entry is captured by address (unordered_map nodes are stable) so the
+    // job copies neither the handler nor the name.
+    thread_pool_.submit_droppable([entry = &entry, name = &type_name, payload = std::move(payload), deadline, this]() {
+        const std::string& type_name = *name;
+        // Start receive span
+        TRACE_SPAN("ServiceHost::receive_message");
+        _trace_span.add_attributes({
+            {"messaging.operation", "receive"},
+            {"messaging.destination", type_name},
+            {"service.name", service_name_},
+            {"service.instance.id", uid_}
+        });
+
+        if (Logger::get_level() <= Logger::Level::DEBUG) {
+            auto [trace_id, span_id] = _trace_span.get_trace_and_span_ids();
+            std::ostringstream thread_id_stream;
+            thread_id_stream << std::this_thread::get_id();
+            logger_->debug("Processing {} in worker thread {} trace_id={} span_id={}", type_name, thread_id_stream.str(), trace_id, span_id);
+        }
+        entry->handler(payload, deadline);
+    }, entry.admission_key, entry.priority, deadline);
+}
+
 // 🚀 Performance benchmarking and validation
 void ServiceHost::run_performance_benchmark(int iterations, bool verbose) {
     if (verbose) {
@@ -674,25 +863,22 @@ void ServiceHost::StartService(const ServiceInitConfig& config) {
     std::cout << "🚀 " << service_name_ << " service started successfully!" << std::endl;
 }
 
-std::future<void> ServiceHost::StartServiceAsync(const ServiceInitConfig& config) {
+TaskFuture<void> ServiceHost::StartServiceAsync(const ServiceInitConfig& config) {
     logger_->info("🚀 Starting async service startup for: {}", service_name_);
     
-    return std::async(std::launch::async, [this, config]() {
+    return thread_pool_.submit_with_result([this, config]() {
         // Run the full startup process in background
         StartService(config);
     });
 }
 
-std::future<void> ServiceHost::StartServiceInfrastructureAsync(const ServiceInitConfig& config) {
+TaskFuture<void> ServiceHost::StartServiceInfrastructureAsync(const ServiceInitConfig& config) {
     logger_->info("🚀 Starting async infrastructure initialization for: {}", service_name_);
     
-    std::promise<void> prom;
-    auto fut = prom.get_future();
-    
-    // Capture `this` by pointer safely; detach thread
-    std::thread([this, config, prom = std::move(prom)]() mutable {
+    // Runs on a pool worker; the returned future carries any exception
+    return thread_pool_.submit_with_result([this, config]() {
         try {
-            logger_->info("🚀 Starting infrastructure initialization in background thread");
+            logger_->info("🚀 Starting infrastructure initialization on the thread pool");
             
             // 1️⃣ Start configuration file watching
             try {
@@ -763,29 +949,21 @@ std::future<void> ServiceHost::StartServiceInfrastructureAsync(const ServiceInit
             
             logger_->info("✅ Infrastructure initialization completed successfully");
             
-            // 9️⃣ Signal success
-            prom.set_value();
-            
         } catch (...) {
             logger_->error("❌ Infrastructure initialization failed");
             // Propagate any exception
-            prom.set_exception(std::current_exception());
+            throw;
         }
-    }).detach();
-    
-    return fut;
+    });
 }
 
-std::future<void> ServiceHost::CompleteServiceStartup(const ServiceInitConfig& config) {
+TaskFuture<void> ServiceHost::CompleteServiceStartup(const ServiceInitConfig& config) {
     logger_->info("🚀 Completing service startup for: {}", service_name_);
     
-    std::promise<void> prom;
-    auto fut = prom.get_future();
-    
-    // Capture `this` by pointer safely; detach thread
-    std::thread([this, config, prom = std::move(prom)]() mutable {
+    // Runs on a pool worker; the returned future carries any exception
+    return thread_pool_.submit_with_result([this, config]() {
         try {
-            logger_->info("🚀 Starting complete service startup in background thread");
+            logger_->info("🚀 Starting complete service startup on the thread pool");
             
             // 1️⃣ Start configuration file watching
             try {
@@ -914,21 +1092,29 @@ std::future<void> ServiceHost::CompleteServiceStartup(const ServiceInitConfig& c
             
             logger_->info("✅ Complete service startup finished successfully");
             
-            // 1️⃣4️⃣ Signal success
-            prom.set_value();
-            
         } catch (...) {
             logger_->error("❌ Complete service startup failed");
             // Propagate any exception
-            prom.set_exception(std::current_exception());
+            throw;
         }
-    }).detach();
-    
-    return fut;
+    });
+}
+
+void ServiceHost::log_thread_pool_placement() const {
+    for (const auto& placement : thread_pool_.worker_placement()) {
+        std::string cpus;
+        for (int cpu : placement.cpus) {
+            cpus += (cpus.empty() ? "" : ",") + std::to_string(cpu);
+        }
+        logger_->info("🧵 Worker {}: node {}, affinity [{}], running on CPU {}",
+                      placement.worker, placement.node,
+                      cpus.empty() ? "any" : cpus, placement.last_cpu);
+    }
 }
 
 void ServiceHost::initialize_service(const ServiceInitConfig& config) {
     logger_->info("🚀 Starting core service initialization for: {}", service_name_);
+    log_thread_pool_placement();
     
     // 1️⃣ Initialize NATS Connection
     try {
@@ -986,11 +1172,13 @@ void ServiceHost::initialize_service(const ServiceInitConfig& config) {
 // Explicit template instantiation
 template void ServiceHost::register_message<Trevor::HealthCheckRequest>(
     MessageRouting routing,
-    std::function<void(const Trevor::HealthCheckRequest&)> handler);
+    std::function<void(const Trevor::HealthCheckRequest&)> handler,
+    TaskPriority priority);
 
 template void ServiceHost::register_message<Trevor::HealthCheckResponse>(
     MessageRouting routing,
-    std::function<void(const Trevor::HealthCheckResponse&)> handler);
+    std::function<void(const Trevor::HealthCheckResponse&)> handler,
+    TaskPriority priority);
 
 // 🚀 NEW: Simplified Handler Registration Implementation
 void ServiceHost::register_handlers(const RegistrationMap& regs) {
@@ -1000,25 +1188,62 @@ void ServiceHost::register_handlers(const RegistrationMap& regs) {
     }
 }
 
+void ServiceHost::deliver_raw(natsConnection*, natsSubscription*, natsMsg* msg, void* closure) {
+    auto* slot = static_cast<SubscriptionSlot*>(closure);
+    ServiceHost* host = slot->host;
+    slot->delivered.fetch_add(1, std::memory_order_relaxed);
+
+    // Update received messages counter
+    if (host->messages_received_total_) {
+        host->messages_received_total_->inc();
+    }
+
+    // Execute handler in thread pool with metrics timing
+    const RegisteredHandler* entry = slot->entry;
+    host->thread_pool_.submit_droppable([entry, payload = MessageBuffer::adopt(msg), host]() {
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        try {
+            entry->handler(payload, ThreadPool::kNoDeadline);
+        } catch (const std::exception& e) {
+            // Handler already logs errors, just update metrics if needed
+        }
+
+        // Update handler duration metrics
+        if (host->message_handler_duration_) {
+            auto end_time = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+            host->message_handler_duration_->observe(duration.count() / 1000000.0);
+        }
+    }, entry->admission_key, entry->priority);
+}
+
 void ServiceHost::register_handler(const std::string& message_type, 
                                  MessageRouting routing, 
                                  HandlerRaw handler) {
     
     logger_->info("Registering handler for message type: {}, routing: {}", 
-                 message_type, routing == MessageRouting::PointToPoint ? "PointToPoint" : "Broadcast");
+                 message_type, routing_name(routing));
     
     // Create a generic handler that works with raw payloads
-    auto generic_handler = [this, handler, message_type](const std::string& payload) {
+    auto generic_handler = [this, handler, message_type](const MessageBuffer& payload, ThreadPool::Deadline) {
         try {
-            // Call the user's handler with the raw payload
-            handler(payload);
+            // Call the user's handler with the raw payload (HandlerRaw takes
+            // a std::string, so this is the one copy on this path)
+            handler(std::string(payload.view()));
         } catch (const std::exception& e) {
             logger_->error("Handler for {} failed: {}", message_type, e.what());
         }
     };
     
     // Store the handler in our handlers map
-    handlers_[message_type] = generic_handler;
+    handlers_[message_type] = RegisteredHandler{generic_handler, TaskPriority::Normal, false,
+                                                admission_key(message_type)};
+    
+    SubscriptionSlot* slot = bind_subscription(message_type, routing);
+    if (!slot) {
+        return;
+    }
     
     // Set up NATS subscription based on routing
     if (routing == MessageRouting::PointToPoint) {
@@ -1026,50 +1251,7 @@ void ServiceHost::register_handler(const std::string& message_type,
         std::string subject = uid_ + "." + message_type;
         
         natsSubscription* sub = nullptr;
-        natsStatus status = natsConnection_Subscribe(&sub, conn_, subject.c_str(),
-            [](natsConnection* conn, natsSubscription* sub, natsMsg* msg, void* closure) {
-                ServiceHost* host = static_cast<ServiceHost*>(closure);
-                const char* subject = natsMsg_GetSubject(msg);
-                const char* data = natsMsg_GetData(msg);
-                int data_len = natsMsg_GetDataLength(msg);
-                
-                std::string payload(data, data_len);
-                
-                // Extract message type from subject (format: uid.MessageType)
-                std::string subject_str(subject);
-                size_t dot_pos = subject_str.find('.');
-                if (dot_pos != std::string::npos) {
-                    std::string msg_type = subject_str.substr(dot_pos + 1);
-                    
-                    auto it = host->handlers_.find(msg_type);
-                    if (it != host->handlers_.end()) {
-                        // Update received messages counter
-                        if (host->messages_received_total_) {
-                            host->messages_received_total_->inc();
-                        }
-                        
-                        // Execute handler in thread pool with metrics timing
-                        host->thread_pool_.submit([handler = it->second, payload, host]() {
-                            auto start_time = std::chrono::high_resolution_clock::now();
-                            
-                            try {
-                                handler(payload);
-                            } catch (const std::exception& e) {
-                                // Handler already logs errors, just update metrics if needed
-                            }
-                            
-                            // Update handler duration metrics
-                            if (host->message_handler_duration_) {
-                                auto end_time = std::chrono::high_resolution_clock::now();
-                                auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
-                                host->message_handler_duration_->observe(duration.count() / 1000000.0);
-                            }
-                        });
-                    }
-                }
-                
-                natsMsg_Destroy(msg);
-            }, this);
+        natsStatus status = natsConnection_Subscribe(&sub, conn_, subject.c_str(), &ServiceHost::deliver_raw, slot);
             
         if (status == NATS_OK) {
             logger_->info("Successfully subscribed to point-to-point subject: {}", subject);
@@ -1077,49 +1259,30 @@ void ServiceHost::register_handler(const std::string& message_type,
             logger_->error("Failed to subscribe to point-to-point subject: {}", subject);
         }
         
+    } else if (routing == MessageRouting::QueueGroup) {
+        // Queue group: general subject, one instance of this service per message
+        std::string subject = message_type;
+        std::string queue = config_.get<std::string>("nats.queue_group", "");
+        if (queue.empty()) {
+            queue = service_name_;
+        }
+        
+        natsSubscription* sub = nullptr;
+        natsStatus status = natsConnection_QueueSubscribe(&sub, conn_, subject.c_str(), queue.c_str(),
+                                                          &ServiceHost::deliver_raw, slot);
+            
+        if (status == NATS_OK) {
+            logger_->info("Successfully subscribed to queue group subject: {} [{}]", subject, queue);
+        } else {
+            logger_->error("Failed to subscribe to queue group subject: {}", subject);
+        }
+        
     } else { // Broadcast
         // Broadcast: subscribe to general subject
         std::string subject = message_type;
         
         natsSubscription* sub = nullptr;
-        natsStatus status = natsConnection_Subscribe(&sub, conn_, subject.c_str(),
-            [](natsConnection* conn, natsSubscription* sub, natsMsg* msg, void* closure) {
-                ServiceHost* host = static_cast<ServiceHost*>(closure);
-                const char* subject = natsMsg_GetSubject(msg);
-                const char* data = natsMsg_GetData(msg);
-                int data_len = natsMsg_GetDataLength(msg);
-                
-                std::string payload(data, data_len);
-                std::string msg_type(subject);
-                
-                auto it = host->handlers_.find(msg_type);
-                if (it != host->handlers_.end()) {
-                    // Update received messages counter
-                    if (host->messages_received_total_) {
-                        host->messages_received_total_->inc();
-                    }
-                    
-                    // Execute handler in thread pool with metrics timing
-                    host->thread_pool_.submit([handler = it->second, payload, host]() {
-                        auto start_time = std::chrono::high_resolution_clock::now();
-                        
-                        try {
-                            handler(payload);
-                        } catch (const std::exception& e) {
-                            // Handler already logs errors, just update metrics if needed
-                        }
-                        
-                        // Update handler duration metrics
-                        if (host->message_handler_duration_) {
-                            auto end_time = std::chrono::high_resolution_clock::now();
-                            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
-                            host->message_handler_duration_->observe(duration.count() / 1000000.0);
-                        }
-                    });
-                }
-                
-                natsMsg_Destroy(msg);
-            }, this);
+        natsStatus status = natsConnection_Subscribe(&sub, conn_, subject.c_str(), &ServiceHost::deliver_raw, slot);
             
         if (status == NATS_OK) {
             logger_->info("Successfully subscribed to broadcast subject: {}", subject);
@@ -1153,7 +1316,8 @@ void ServiceHost::StartPermanentTasks(const ServiceInitConfig& config) {
             if (permanent_tasks_running_.load()) {
                 execute_permanent_maintenance_cycle();
             }
-        }
+        },
+        ServiceScheduler::TaskConfig::create_high_priority()  // Must not queue behind data-plane work
     );
     
     logger_->info("✅ Permanent tasks started with interval: {}s", 
@@ -1278,6 +1442,22 @@ void ServiceHost::execute_backpressure_check_task() {
             // For example: reduce processing rate, reject new requests, etc.
         }
         
+        // Report what the bounded queue shed or delayed since the last check
+        size_t rejected = thread_pool_.rejected_tasks();
+        size_t dropped = thread_pool_.dropped_tasks();
+        size_t blocked = thread_pool_.blocked_submissions();
+        if (rejected > backpressure_last_rejected_ || dropped > backpressure_last_dropped_ ||
+            blocked > backpressure_last_blocked_) {
+            logger_->warn("🚧 Admission control active (capacity: {}) - rejected: {}, dropped: {}, blocked: {} since last check",
+                         thread_pool_.capacity(),
+                         rejected - backpressure_last_rejected_,
+                         dropped - backpressure_last_dropped_,
+                         blocked - backpressure_last_blocked_);
+        }
+        backpressure_last_rejected_ = rejected;
+        backpressure_last_dropped_ = dropped;
+        backpressure_last_blocked_ = blocked;
+        
         logger_->trace("📊 Backpressure check completed - Queue size: {}", current_queue_size);
         
     } catch (const std::exception& e) {
@@ -1435,6 +1615,98 @@ void ServiceHost::init_prometheus_metrics(const ServiceInitConfig& config) {
                 "Number of tasks in the thread pool queue",
                 service_labels
             );
+            
+            thread_pool_heap_spilled_tasks_ = registry.create_gauge(
+                "servicehost_thread_pool_heap_spilled_tasks",
+                "Number of thread pool tasks whose captures spilled to the heap",
+                service_labels
+            );
+            
+            thread_pool_rejected_total_ = registry.create_counter(
+                "servicehost_thread_pool_rejected_total",
+                "Tasks refused by the bounded thread pool queue",
+                service_labels
+            );
+            
+            thread_pool_dropped_total_ = registry.create_counter(
+                "servicehost_thread_pool_dropped_total",
+                "Queued tasks evicted by the drop-oldest / drop-newest-by-key policies",
+                service_labels
+            );
+            
+            thread_pool_blocked_total_ = registry.create_counter(
+                "servicehost_thread_pool_blocked_total",
+                "Submissions that waited for room in the bounded thread pool queue",
+                service_labels
+            );
+            
+            thread_pool_expired_total_ = registry.create_counter(
+                "servicehost_thread_pool_expired_total",
+                "Queued tasks and parsed messages dropped because their deadline passed",
+                service_labels
+            );
+            
+            messages_conflated_total_ = registry.create_counter(
+                "servicehost_messages_conflated_total",
+                "Messages replaced by a newer one for the same key before their handler ran",
+                service_labels
+            );
+            
+            batch_messages_dropped_total_ = registry.create_counter(
+                "servicehost_batch_messages_dropped_total",
+                "Messages lost because the thread pool refused their batch",
+                service_labels
+            );
+            
+            if (thread_pool_.is_elastic()) {
+                thread_pool_grow_total_ = registry.create_counter(
+                    "servicehost_thread_pool_grow_total",
+                    "Elastic thread pool decisions to add a worker",
+                    service_labels
+                );
+                thread_pool_shrink_total_ = registry.create_counter(
+                    "servicehost_thread_pool_shrink_total",
+                    "Elastic thread pool decisions to retire a worker",
+                    service_labels
+                );
+                thread_pool_queue_wait_seconds_ = registry.create_gauge(
+                    "servicehost_thread_pool_queue_wait_seconds",
+                    "Queue wait the last elastic resize decision was based on",
+                    service_labels
+                );
+            }
+            
+            if (thread_pool_.timing_enabled()) {
+                std::vector<double> bounds;
+                for (size_t bucket : exported_timing_buckets()) {
+                    bounds.push_back(ThreadPool::timing_bucket_bound_ns(bucket) / 1e9);
+                }
+                thread_pool_task_wait_ = registry.create_histogram(
+                    "servicehost_thread_pool_task_wait_seconds",
+                    "Time tasks spent queued before a worker picked them up",
+                    bounds,
+                    service_labels
+                );
+                thread_pool_task_run_ = registry.create_histogram(
+                    "servicehost_thread_pool_task_run_seconds",
+                    "Time workers spent executing each task",
+                    bounds,
+                    service_labels
+                );
+            }
+            
+            // One series per worker: the CPU it was last observed on
+            thread_pool_worker_cpu_.clear();
+            for (const auto& placement : thread_pool_.worker_placement()) {
+                auto worker_labels = service_labels;
+                worker_labels["worker"] = std::to_string(placement.worker);
+                worker_labels["numa_node"] = std::to_string(placement.node);
+                thread_pool_worker_cpu_.push_back(registry.create_gauge(
+                    "servicehost_thread_pool_worker_cpu",
+                    "CPU each thread pool worker was last observed running on",
+                    worker_labels
+                ));
+            }
         }
         
         // NATS metrics
@@ -1527,6 +1799,95 @@ void ServiceHost::update_system_metrics() {
             thread_pool_queue_size_->set(static_cast<double>(thread_pool_.pending_tasks()));
         }
         
+        if (thread_pool_heap_spilled_tasks_) {
+            thread_pool_heap_spilled_tasks_->set(static_cast<double>(thread_pool_.heap_spilled_tasks()));
+        }
+        
+        // Pool counters are cumulative; advance the Prometheus counters by the delta
+        if (thread_pool_rejected_total_) {
+            size_t rejected = thread_pool_.rejected_tasks();
+            thread_pool_rejected_total_->inc(static_cast<double>(rejected - exported_rejected_));
+            exported_rejected_ = rejected;
+        }
+        
+        if (thread_pool_dropped_total_) {
+            size_t dropped = thread_pool_.dropped_tasks();
+            thread_pool_dropped_total_->inc(static_cast<double>(dropped - exported_dropped_));
+            exported_dropped_ = dropped;
+        }
+        
+        if (thread_pool_blocked_total_) {
+            size_t blocked = thread_pool_.blocked_submissions();
+            thread_pool_blocked_total_->inc(static_cast<double>(blocked - exported_blocked_));
+            exported_blocked_ = blocked;
+        }
+        
+        if (thread_pool_expired_total_) {
+            size_t expired = thread_pool_.expired_tasks() + expired_messages_.load(std::memory_order_relaxed);
+            thread_pool_expired_total_->inc(static_cast<double>(expired - exported_expired_));
+            exported_expired_ = expired;
+        }
+        
+        if (messages_received_total_) {
+            // Per-subscription delivery counts: compare instances of a
+            // queue group to check the load is balanced
+            std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+            for (auto& slot : subscriptions_) {
+                if (!slot->delivered_total) {
+                    slot->delivered_total = PrometheusMetrics::MetricsRegistry::instance().create_counter(
+                        "servicehost_messages_delivered_total",
+                        "Messages delivered to this instance by NATS, per subscription",
+                        {{"service", service_name_}, {"instance", uid_},
+                         {"message_type", *slot->type_name}, {"routing", routing_name(slot->routing)}});
+                }
+                size_t delivered = slot->delivered.load(std::memory_order_relaxed);
+                slot->delivered_total->inc(static_cast<double>(delivered - slot->exported));
+                slot->exported = delivered;
+            }
+        }
+        
+        if (messages_conflated_total_) {
+            size_t conflated = conflating_inbox_.conflated();
+            messages_conflated_total_->inc(static_cast<double>(conflated - exported_conflated_));
+            exported_conflated_ = conflated;
+        }
+        
+        if (batch_messages_dropped_total_) {
+            size_t dropped = dropped_batch_messages_.load(std::memory_order_relaxed);
+            batch_messages_dropped_total_->inc(static_cast<double>(dropped - exported_batch_dropped_));
+            exported_batch_dropped_ = dropped;
+        }
+        
+        if (thread_pool_task_wait_ && thread_pool_task_run_) {
+            auto timings = thread_pool_.task_timings();
+            export_timing_histogram(*thread_pool_task_wait_, timings.queue_wait);
+            export_timing_histogram(*thread_pool_task_run_, timings.run);
+        }
+        
+        if (thread_pool_grow_total_) {
+            size_t grows = thread_pool_.grow_events();
+            thread_pool_grow_total_->inc(static_cast<double>(grows - exported_grows_));
+            exported_grows_ = grows;
+        }
+        
+        if (thread_pool_shrink_total_) {
+            size_t shrinks = thread_pool_.shrink_events();
+            thread_pool_shrink_total_->inc(static_cast<double>(shrinks - exported_shrinks_));
+            exported_shrinks_ = shrinks;
+        }
+        
+        if (thread_pool_queue_wait_seconds_) {
+            thread_pool_queue_wait_seconds_->set(
+                std::chrono::duration<double>(thread_pool_.measured_queue_wait()).count());
+        }
+        
+        if (!thread_pool_worker_cpu_.empty()) {
+            auto placement = thread_pool_.worker_placement();
+            for (size_t i = 0; i < placement.size() && i < thread_pool_worker_cpu_.size(); ++i) {
+                thread_pool_worker_cpu_[i]->set(static_cast<double>(placement[i].last_cpu));
+            }
+        }
+        
         // Update NATS connection status
         if (active_connections_) {
             active_connections_->set(conn_ ? 1.0 : 0.0);
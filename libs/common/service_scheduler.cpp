@@ -2,6 +2,7 @@
 #include "thread_pool.hpp"
 #include "logger.hpp"
 #include <algorithm>
+#include <array>
 #include <sstream>
 
 ServiceScheduler::ServiceScheduler(ThreadPool* pool, std::shared_ptr<Logger> logger)
@@ -11,6 +12,19 @@ ServiceScheduler::ServiceScheduler(ThreadPool* pool, std::shared_ptr<Logger> log
 
 ServiceScheduler::~ServiceScheduler() {
     stop();
+    
+    // Tasks already handed to the pool still touch their ScheduledTask;
+    // let them finish before tasks_ is destroyed
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(tasks_mutex_);
+            if (std::none_of(tasks_.begin(), tasks_.end(),
+                             [](const std::unique_ptr<ScheduledTask>& task) { return task->running.load(); })) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
 }
 
 void ServiceScheduler::start() {
@@ -20,6 +34,10 @@ void ServiceScheduler::start() {
     }
     
     logger_->info("Starting ServiceScheduler");
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        stopped_ = false;
+    }
     scheduler_thread_ = std::thread(&ServiceScheduler::scheduler_loop, this);
 }
 
@@ -31,17 +49,28 @@ void ServiceScheduler::stop() {
     logger_->info("Stopping ServiceScheduler");
     
     // Wake up scheduler thread
-    cv_.notify_all();
+    wake_scheduler();
     
     // Wait for scheduler thread to finish
     if (scheduler_thread_.joinable()) {
         scheduler_thread_.join();
     }
     
-    // Cancel all running tasks
-    std::lock_guard<std::mutex> lock(tasks_mutex_);
-    for (auto& task : tasks_) {
-        task->config.enabled = false;
+    // Cancel all running tasks; release the run_on_stop ones still pending
+    std::vector<std::pair<TaskFunction, TaskPriority>> released;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex_);
+        stopped_ = true;
+        for (auto& task : tasks_) {
+            task->config.enabled = false;
+            if (task->config.run_on_stop && task->config.mode == ExecutionMode::ONE_TIME &&
+                !task->running.load() && !task->finished.exchange(true)) {
+                released.emplace_back(std::move(task->function), task->config.priority);
+            }
+        }
+    }
+    for (auto& [function, priority] : released) {
+        run_released(std::move(function), priority);
     }
     
     logger_->info("ServiceScheduler stopped");
@@ -69,11 +98,17 @@ ServiceScheduler::TaskId ServiceScheduler::schedule_interval(
     auto scheduled_task = std::make_unique<ScheduledTask>(id, final_config, 
                                                          std::move(task), interval);
     
-    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    std::unique_lock<std::mutex> lock(tasks_mutex_);
+    if (stopped_ && final_config.run_on_stop && final_config.mode == ExecutionMode::ONE_TIME) {
+        // Added after stop() released its tasks: nothing would ever fire it
+        lock.unlock();
+        run_released(std::move(scheduled_task->function), final_config.priority);
+        return id;
+    }
     tasks_.push_back(std::move(scheduled_task));
     
     logger_->debug("Scheduled interval task: {} ({}ms interval)", name, interval.count());
-    cv_.notify_one();
+    wake_scheduler();
     
     return id;
 }
@@ -186,7 +221,7 @@ bool ServiceScheduler::enable_task(TaskId id) {
         (*it)->config.enabled = true;
         (*it)->stats.enabled = true;
         logger_->debug("Enabled task: {}", (*it)->config.name);
-        cv_.notify_one();
+        wake_scheduler();
         return true;
     }
     
@@ -282,21 +317,19 @@ void ServiceScheduler::scheduler_loop() {
     while (running_.load()) {
         try {
             // Check for ready tasks
-            std::vector<std::unique_ptr<ScheduledTask>*> ready_tasks;
+            std::vector<ScheduledTask*> ready_tasks;
             
             {
                 std::lock_guard<std::mutex> lock(tasks_mutex_);
                 for (auto& task : tasks_) {
                     if (task->should_execute()) {
-                        ready_tasks.push_back(&task);
+                        ready_tasks.push_back(task.get());
                     }
                 }
             }
             
-            // Execute ready tasks
-            for (auto* task_ptr : ready_tasks) {
-                execute_task(*task_ptr);
-            }
+            // Execute ready tasks (one pool submission for the whole set)
+            dispatch_ready_tasks(ready_tasks);
             
             // Cleanup completed one-time tasks
             cleanup_completed_tasks();
@@ -304,8 +337,10 @@ void ServiceScheduler::scheduler_loop() {
             // Sleep until next task is ready
             auto next_wake = get_next_wake_time();
             
+            // New or re-enabled tasks may be due before next_wake
             std::unique_lock<std::mutex> cv_lock(cv_mutex_);
-            cv_.wait_for(cv_lock, next_wake, [this] { return !running_.load(); });
+            cv_.wait_for(cv_lock, next_wake, [this] { return !running_.load() || wake_requested_; });
+            wake_requested_ = false;
             
         } catch (const std::exception& e) {
             logger_->error("Scheduler loop error: {}", e.what());
@@ -316,16 +351,47 @@ void ServiceScheduler::scheduler_loop() {
     logger_->debug("Scheduler loop stopped");
 }
 
-void ServiceScheduler::execute_task(std::unique_ptr<ScheduledTask>& task) {
-    if (!task->config.enabled || task->running.load()) {
-        return;
+void ServiceScheduler::wake_scheduler() {
+    {
+        std::lock_guard<std::mutex> lock(cv_mutex_);
+        wake_requested_ = true;
+    }
+    cv_.notify_all();
+}
+
+void ServiceScheduler::dispatch_ready_tasks(const std::vector<ScheduledTask*>& ready_tasks) {
+    // One batch per ThreadPool lane, indexed by TaskPriority
+    std::array<std::vector<InlineTask>, ThreadPool::kLaneCount> batches;
+    std::array<std::vector<ScheduledTask*>, ThreadPool::kLaneCount> claimed;
+    
+    for (auto* task : ready_tasks) {
+        if (!task->config.enabled || task->running.exchange(true)) {
+            continue;
+        }
+        size_t lane = static_cast<size_t>(task->config.priority);
+        batches[lane].push_back(make_task_execution(task));
+        claimed[lane].push_back(task);
     }
     
-    task->running.store(true);
+    for (size_t lane = 0; lane < ThreadPool::kLaneCount; ++lane) {
+        if (batches[lane].empty()) {
+            continue;
+        }
+        
+        // Single lock acquisition and wake-up pass for all ready tasks in this lane
+        if (!thread_pool_->submit_batch(batches[lane], static_cast<TaskPriority>(lane))) {
+            logger_->warn("Thread pool rejected {} scheduled tasks (shutting down)", claimed[lane].size());
+            for (auto* task : claimed[lane]) {
+                task->running.store(false);
+            }
+        }
+    }
+}
+
+InlineTask ServiceScheduler::make_task_execution(ScheduledTask* task) {
     auto start_time = std::chrono::steady_clock::now();
     
-    // Submit to thread pool
-    thread_pool_->submit([this, &task, start_time]() {
+    return InlineTask([this, task, start_time]() {
         try {
             logger_->trace("Executing scheduled task: {}", task->config.name);
             
@@ -364,21 +430,34 @@ void ServiceScheduler::execute_task(std::unique_ptr<ScheduledTask>& task) {
         // Schedule next execution for recurring tasks
         if (task->config.mode == ExecutionMode::RECURRING) {
             task->calculate_next_run();
+        } else if (task->config.mode == ExecutionMode::ONE_TIME) {
+            task->finished.store(true); // Even if it threw: one-time means once
         }
         
         task->running.store(false);
     });
 }
 
+void ServiceScheduler::run_released(TaskFunction function, TaskPriority priority) {
+    if (thread_pool_->submit(function, priority)) {
+        return;
+    }
+    try {
+        function();
+    } catch (const std::exception& e) {
+        logger_->error("Task failed on stop: {}", e.what());
+    } catch (...) {
+        logger_->error("Task failed on stop with unknown exception");
+    }
+}
+
 void ServiceScheduler::cleanup_completed_tasks() {
     std::lock_guard<std::mutex> lock(tasks_mutex_);
     
     tasks_.erase(
         std::remove_if(tasks_.begin(), tasks_.end(),
                       [](const std::unique_ptr<ScheduledTask>& task) {
-                          return task->config.mode == ExecutionMode::ONE_TIME &&
-                                 task->stats.executions > 0 &&
-                                 !task->running.load();
+                          return task->finished.load() && !task->running.load();
                       }),
         tasks_.end()
     );
@@ -397,5 +476,6 @@ std::chrono::milliseconds ServiceScheduler::get_next_wake_time() const {
     }
     
     auto sleep_duration = next_time - now;
-    return std::chrono::duration_cast<std::chrono::milliseconds>(sleep_duration);
+    // Round up: a truncated sub-millisecond wait would spin until the task is due
+    return std::chrono::ceil<std::chrono::milliseconds>(sleep_duration);
 }
@@ -12,8 +12,10 @@
 #include <string>
 #include <condition_variable>
 
+#include "inline_task.hpp"
+#include "thread_pool.hpp"
+
 // Forward declarations
-class ThreadPool;
 class Logger;
 
 /**
@@ -55,6 +57,8 @@ public:
         std::chrono::milliseconds timeout = std::chrono::milliseconds(5000);
         int max_retries = 3;
         std::function<bool()> condition = nullptr; // For conditional tasks
+        TaskPriority priority = TaskPriority::Normal; // ThreadPool lane used when the task fires
+        bool run_on_stop = false; // ONE_TIME: still pending at stop() (or added after it), run then instead of never
         
         // Static method to create default config
         static TaskConfig create_default() {
@@ -64,6 +68,15 @@ public:
             config.timeout = std::chrono::milliseconds(5000);
             config.max_retries = 3;
             config.condition = nullptr;
+            config.priority = TaskPriority::Normal;
+            config.run_on_stop = false;
+            return config;
+        }
+        
+        // Default config on the High lane, for health and maintenance work
+        static TaskConfig create_high_priority() {
+            TaskConfig config = create_default();
+            config.priority = TaskPriority::High;
             return config;
         }
     };
@@ -89,6 +102,7 @@ private:
         std::chrono::milliseconds interval;
         TaskStats stats;
         std::atomic<bool> running{false};
+        std::atomic<bool> finished{false}; // ONE_TIME task has run; never dispatch again
         
         ScheduledTask(TaskId task_id, const TaskConfig& cfg, TaskFunction func, 
                      std::chrono::milliseconds inter)
@@ -106,7 +120,7 @@ private:
         bool is_ready() const {
             return config.enabled && 
                    std::chrono::steady_clock::now() >= next_run &&
-                   !running.load();
+                   !running.load() && !finished.load();
         }
         
         bool should_execute() const {
@@ -123,10 +137,12 @@ private:
     std::vector<std::unique_ptr<ScheduledTask>> tasks_;
     mutable std::mutex tasks_mutex_;
     std::atomic<bool> running_{false};
+    bool stopped_ = false; // stop() has released run_on_stop tasks; guarded by tasks_mutex_
     std::atomic<TaskId> next_task_id_{1};
     std::thread scheduler_thread_;
     std::condition_variable cv_;
     std::mutex cv_mutex_;
+    bool wake_requested_ = false; // Re-scan tasks before next_wake; guarded by cv_mutex_
     
     // Performance monitoring
     std::atomic<size_t> total_executions_{0};
@@ -144,9 +160,12 @@ public:
     // Start the scheduler
     void start();
     
-    // Stop the scheduler
+    // Stop the scheduler. Pending run_on_stop tasks are handed to the pool,
+    // or run on the calling thread if it refuses them.
     void stop();
     
+    bool is_running() const { return running_.load(); }
+    
     // Schedule a task to run every N seconds
     // Schedule a task to run at specified intervals
     TaskId schedule_interval(const std::string& name, 
@@ -232,14 +251,14 @@ public:
     // Schedule health check heartbeat every 10 seconds
     TaskId schedule_health_heartbeat(TaskFunction heartbeat_func) {
         return schedule_interval("health_heartbeat", std::chrono::seconds(10),
-                               std::move(heartbeat_func));
+                               std::move(heartbeat_func), TaskConfig::create_high_priority());
     }
     
     // Schedule back-pressure monitoring every 1 second
     TaskId schedule_backpressure_monitor(std::function<size_t()> queue_size_func,
                                         size_t threshold,
                                         TaskFunction alert_func) {
-        TaskConfig config;
+        TaskConfig config = TaskConfig::create_high_priority();
         config.name = "backpressure_monitor";
         config.condition = [queue_size_func, threshold]() {
             return queue_size_func() > threshold;
@@ -251,7 +270,12 @@ public:
     
 private:
     void scheduler_loop();
-    void execute_task(std::unique_ptr<ScheduledTask>& task);
+    void dispatch_ready_tasks(const std::vector<ScheduledTask*>& ready_tasks);
+    InlineTask make_task_execution(ScheduledTask* task);
     void cleanup_completed_tasks();
+    // Run a released run_on_stop task on the pool, or inline if refused
+    void run_released(TaskFunction function, TaskPriority priority);
     std::chrono::milliseconds get_next_wake_time() const;
+    // Make scheduler_loop() re-scan now (a task was added, enabled or stop())
+    void wake_scheduler();
 };
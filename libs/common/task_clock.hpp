@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Cheap monotonic timestamps for per-task instrumentation
+ *
+ * On x86 now() is a bare RDTSC (a few ns, no syscall or vDSO call); the
+ * tick rate is calibrated against steady_clock once per process, on the
+ * first call to ns_per_tick(). Elsewhere it falls back to steady_clock
+ * nanoseconds. Assumes an invariant TSC, which every x86 server CPU of the
+ * last decade has; differences between cores are clamped to zero.
+ */
+namespace TaskClock {
+
+inline uint64_t now()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+#endif
+}
+
+// Nanoseconds per tick. The first call spins for ~2 ms to calibrate.
+inline double ns_per_tick()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    static const double ratio = []() {
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t first = __rdtsc();
+        auto elapsed = std::chrono::steady_clock::duration::zero();
+        while (elapsed < std::chrono::milliseconds(2)) {
+            elapsed = std::chrono::steady_clock::now() - start;
+        }
+        const uint64_t ticks = __rdtsc() - first;
+        const double ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        return ticks > 0 ? ns / static_cast<double>(ticks) : 1.0;
+    }();
+    return ratio;
+#else
+    return 1.0;
+#endif
+}
+
+// Nanoseconds between two now() readings; 0 if 'to' is not after 'from'
+inline uint64_t elapsed_ns(uint64_t from, uint64_t to)
+{
+    return to > from ? static_cast<uint64_t>(static_cast<double>(to - from) * ns_per_tick()) : 0;
+}
+
+} // namespace TaskClock
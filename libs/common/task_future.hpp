@@ -0,0 +1,323 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "inline_task.hpp"
+
+class ThreadPool;
+
+template <typename T>
+class TaskFuture;
+
+namespace task_future_detail {
+
+// Run 'task' on 'pool'; false if the pool refused it (shut down or full).
+// Defined in thread_pool.hpp.
+bool post(ThreadPool& pool, InlineTask&& task);
+
+struct Unit {};
+
+template <typename T>
+using Stored = std::conditional_t<std::is_void_v<T>, Unit, T>;
+
+template <typename T>
+struct State {
+    explicit State(ThreadPool* p) : pool(p) {}
+
+    ThreadPool* pool;  // Where continuations run; nullptr = inline
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool ready = false;
+    std::optional<Stored<T>> value;
+    std::exception_ptr error;
+    std::vector<InlineTask> callbacks;  // Run inline by the completing thread
+
+    // Publish the result and run callbacks registered before completion
+    template <typename Fill>
+    void complete(Fill&& fill) {
+        std::vector<InlineTask> ready_callbacks;
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            if (ready) {
+                return;
+            }
+            fill();
+            ready = true;
+            ready_callbacks.swap(callbacks);
+        }
+        cv.notify_all();
+        for (auto& callback : ready_callbacks) {
+            callback();
+        }
+    }
+
+    // Run 'callback' once the result is available (now, if it already is)
+    void on_ready(InlineTask callback) {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            if (!ready) {
+                callbacks.push_back(std::move(callback));
+                return;
+            }
+        }
+        callback();
+    }
+};
+
+// Hand 'job' to the pool; run it here if there is no pool or it refused
+inline void dispatch(ThreadPool* pool, InlineTask&& job) {
+    if (!pool || !post(*pool, std::move(job))) {
+        job();
+    }
+}
+
+}  // namespace task_future_detail
+
+/**
+ * @brief Producer side of a TaskFuture
+ *
+ * set_value()/set_exception() may be called once; later calls are ignored.
+ * A promise destroyed without a result fails its future with
+ * std::runtime_error("broken promise").
+ */
+template <typename T>
+class TaskPromise {
+public:
+    explicit TaskPromise(ThreadPool* pool = nullptr)
+        : state_(std::make_shared<task_future_detail::State<T>>(pool)) {}
+
+    TaskPromise(TaskPromise&&) noexcept = default;
+    TaskPromise& operator=(TaskPromise&& other) noexcept {
+        if (this != &other) {
+            abandon();
+            state_ = std::move(other.state_);
+        }
+        return *this;
+    }
+    TaskPromise(const TaskPromise&) = delete;
+    TaskPromise& operator=(const TaskPromise&) = delete;
+
+    ~TaskPromise() { abandon(); }
+
+    TaskFuture<T> get_future() const { return TaskFuture<T>(state_); }
+
+    template <typename... Args>
+    void set_value(Args&&... args) {
+        state_->complete([&]() { state_->value.emplace(std::forward<Args>(args)...); });
+    }
+
+    void set_exception(std::exception_ptr error) {
+        state_->complete([&]() { state_->error = std::move(error); });
+    }
+
+private:
+    void abandon() {
+        if (state_ && state_.use_count() > 1) {
+            set_exception(std::make_exception_ptr(std::runtime_error("broken promise")));
+        }
+    }
+
+    std::shared_ptr<task_future_detail::State<T>> state_;
+};
+
+/**
+ * @brief Lightweight shared future for ThreadPool results
+ *
+ * A copyable handle on one shared state (mutex + condition variable +
+ * result), with no thread of its own. Produced by
+ * ThreadPool::submit_with_result(), TaskPromise, then(), when_all() and
+ * when_any().
+ *
+ * then(f) schedules f on the pool once the result is ready and returns a
+ * future for f's result. f receives the value (nothing for TaskFuture<void>);
+ * if this future failed, f is skipped and the exception propagates. If the
+ * pool has shut down, the continuation runs on the completing thread.
+ *
+ * get()/wait() block the caller. Do not block a pool worker on work queued
+ * behind it on the same pool.
+ */
+template <typename T>
+class TaskFuture {
+public:
+    using value_type = T;
+
+    TaskFuture() = default;
+
+    bool valid() const noexcept { return static_cast<bool>(state_); }
+
+    bool is_ready() const {
+        std::lock_guard<std::mutex> lk(state_->mtx);
+        return state_->ready;
+    }
+
+    void wait() const {
+        std::unique_lock<std::mutex> lk(state_->mtx);
+        state_->cv.wait(lk, [this]() { return state_->ready; });
+    }
+
+    template <typename Rep, typename Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+        std::unique_lock<std::mutex> lk(state_->mtx);
+        return state_->cv.wait_for(lk, timeout, [this]() { return state_->ready; });
+    }
+
+    // Block until ready; rethrow the task's exception or return its value
+    std::conditional_t<std::is_void_v<T>, void, const task_future_detail::Stored<T>&> get() const {
+        wait();
+        if (state_->error) {
+            std::rethrow_exception(state_->error);
+        }
+        if constexpr (!std::is_void_v<T>) {
+            return *state_->value;
+        }
+    }
+
+    template <typename F>
+    auto then(F&& f) const {
+        using R = std::conditional_t<std::is_void_v<T>,
+                                     std::invoke_result<std::decay_t<F>>,
+                                     std::invoke_result<std::decay_t<F>, const task_future_detail::Stored<T>&>>;
+        using Result = typename R::type;
+
+        TaskPromise<Result> promise(state_->pool);
+        TaskFuture<Result> next = promise.get_future();
+        state_->on_ready([state = state_, fn = std::forward<F>(f),
+                          promise = std::move(promise)]() mutable {
+            task_future_detail::dispatch(
+                state->pool,
+                [state, fn = std::move(fn), promise = std::move(promise)]() mutable {
+                    if (state->error) {
+                        promise.set_exception(state->error);
+                        return;
+                    }
+                    try {
+                        if constexpr (std::is_void_v<T>) {
+                            fulfil(promise, fn);
+                        } else {
+                            fulfil(promise, fn, *state->value);
+                        }
+                    } catch (...) {
+                        promise.set_exception(std::current_exception());
+                    }
+                });
+        });
+        return next;
+    }
+
+    // Run 'callback' once ready, on this future's pool (inline if it has
+    // none or refused it) whether the task succeeded or failed. This is the
+    // hook coroutine awaiters resume through.
+    void on_ready(InlineTask callback) const {
+        state_->on_ready([state = state_, callback = std::move(callback)]() mutable {
+            task_future_detail::dispatch(state->pool, std::move(callback));
+        });
+    }
+
+private:
+    template <typename U>
+    friend class TaskPromise;
+    template <typename U>
+    friend class TaskFuture;
+    template <typename U>
+    friend auto when_all(const std::vector<TaskFuture<U>>& futures);
+    template <typename U>
+    friend TaskFuture<size_t> when_any(const std::vector<TaskFuture<U>>& futures);
+
+    explicit TaskFuture(std::shared_ptr<task_future_detail::State<T>> state)
+        : state_(std::move(state)) {}
+
+    // Set 'promise' from invoking 'fn(args...)'; exceptions propagate
+    template <typename Result, typename Fn, typename... Args>
+    static void fulfil(TaskPromise<Result>& promise, Fn& fn, Args&&... args) {
+        if constexpr (std::is_void_v<Result>) {
+            fn(std::forward<Args>(args)...);
+            promise.set_value();
+        } else {
+            promise.set_value(fn(std::forward<Args>(args)...));
+        }
+    }
+
+    std::shared_ptr<task_future_detail::State<T>> state_;
+};
+
+/**
+ * @brief Future that completes once every input has completed
+ *
+ * Yields the values in input order (TaskFuture<void> for void inputs). If
+ * any input failed, the result fails with the first failure in input order.
+ * An empty input is ready immediately.
+ */
+template <typename T>
+auto when_all(const std::vector<TaskFuture<T>>& futures) {
+    using Result = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+    ThreadPool* pool = futures.empty() ? nullptr : futures.front().state_->pool;
+    auto promise = std::make_shared<TaskPromise<Result>>(pool);
+    TaskFuture<Result> result = promise->get_future();
+
+    auto inputs = std::make_shared<const std::vector<TaskFuture<T>>>(futures);
+    auto finish = [inputs, promise]() {
+        for (const auto& future : *inputs) {
+            if (future.state_->error) {
+                promise->set_exception(future.state_->error);
+                return;
+            }
+        }
+        if constexpr (std::is_void_v<T>) {
+            promise->set_value();
+        } else {
+            std::vector<T> values;
+            values.reserve(inputs->size());
+            for (const auto& future : *inputs) {
+                values.push_back(*future.state_->value);
+            }
+            promise->set_value(std::move(values));
+        }
+    };
+    if (futures.empty()) {
+        finish();
+        return result;
+    }
+
+    auto remaining = std::make_shared<std::atomic<size_t>>(futures.size());
+    for (const auto& future : futures) {
+        future.state_->on_ready([remaining, finish]() {
+            if (remaining->fetch_sub(1) == 1) {
+                finish();
+            }
+        });
+    }
+    return result;
+}
+
+/**
+ * @brief Future for the index of the first input to complete
+ *
+ * Completes successfully even if that input failed; call get() on the
+ * input to see its outcome. An empty input fails with std::invalid_argument.
+ */
+template <typename T>
+TaskFuture<size_t> when_any(const std::vector<TaskFuture<T>>& futures) {
+    ThreadPool* pool = futures.empty() ? nullptr : futures.front().state_->pool;
+    auto promise = std::make_shared<TaskPromise<size_t>>(pool);
+    TaskFuture<size_t> result = promise->get_future();
+    if (futures.empty()) {
+        promise->set_exception(std::make_exception_ptr(
+            std::invalid_argument("when_any of no futures")));
+        return result;
+    }
+    for (size_t i = 0; i < futures.size(); ++i) {
+        // The first completion wins; later set_value calls are ignored
+        futures[i].state_->on_ready([promise, i]() { promise->set_value(i); });
+    }
+    return result;
+}
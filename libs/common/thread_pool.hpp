@@ -1,46 +1,273 @@
 #pragma once
 #include <vector>
+#include <array>
 #include <thread>
-#include <queue>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <functional>
 #include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#include "inline_task.hpp"
+#include "mpmc_ring.hpp"
+#include "cpu_topology.hpp"
+#include "task_future.hpp"
+#include "task_clock.hpp"
+
+// Per-task queue-wait / run-time histograms (Options::record_timings).
+// Build with -DTHREAD_POOL_TIMING=0 to compile the instrumentation out.
+#ifndef THREAD_POOL_TIMING
+#define THREAD_POOL_TIMING 1
+#endif
+
+// Dequeue lane for a submitted task. High is for control-plane work
+// (health checks, scheduler maintenance) that must not wait behind bulk
+// data-plane traffic such as market data ticks.
+enum class TaskPriority
+{
+    High = 0,
+    Normal = 1
+};
 
 class ThreadPool
 {
 public:
-    ThreadPool(size_t n = std::thread::hardware_concurrency()) : done(false)
+    // How submitted tasks are handed to the workers
+    enum class SchedulingMode
+    {
+        SharedQueue,  // One FIFO behind a single mutex (default)
+        WorkStealing, // Per-worker deques, idle workers steal from their peers
+        LockFreeRing  // One bounded lock-free MPMC ring per lane
+    };
+
+    // How workers choose between the High and Normal lanes
+    enum class LanePolicy
+    {
+        Strict,   // Always drain High first; Normal only runs when High is empty
+        Weighted  // Serve up to high_priority_weight High tasks per Normal task
+    };
+
+    // What a Normal-lane submission does when the queue is at capacity
+    enum class OverflowPolicy
+    {
+        Block,           // Wait for room (submissions from pool workers never wait)
+        Reject,          // Return false
+        DropOldest,      // Evict the oldest droppable task to make room (with deadlines: the least urgent)
+        DropNewestByKey  // Evict the newest droppable task with the same key
+    };
+
+    static constexpr size_t kLaneCount = 2;
+
+    // Latest time a task may start; later it is dropped unrun
+    using Deadline = std::chrono::steady_clock::time_point;
+    static constexpr Deadline kNoDeadline = Deadline::max();
+
+    struct Options
+    {
+        size_t threads = std::thread::hardware_concurrency();
+        SchedulingMode mode = SchedulingMode::SharedQueue;
+        LanePolicy lane_policy = LanePolicy::Strict;
+        size_t high_priority_weight = 8;  // Weighted only; 0 is treated as 1
+
+        // Placement. With cpu_list set, worker i is pinned to
+        // cpu_list[i % size]. With numa_aware, workers are split into one
+        // sub-pool per NUMA node (restricted to cpu_list when given), each
+        // pinned to its node's CPUs; WorkStealing workers steal from their
+        // own node before crossing to another.
+        std::vector<int> cpu_list;
+        bool numa_aware = false;
+
+        // Admission control. Bounds queued Normal-lane tasks; the High lane
+        // is never bounded so control-plane work is always admitted.
+        size_t capacity = 0;  // 0 = unbounded
+        OverflowPolicy overflow = OverflowPolicy::Block;
+
+        // LockFreeRing slots per lane when 'capacity' is 0 (otherwise the
+        // Normal ring holds 'capacity'); rounded up to a power of two. An
+        // external submission to a full ring yields until a slot frees up; a
+        // worker submitting to a full ring runs the task itself. The ring
+        // cannot evict, so DropOldest and DropNewestByKey act like Reject.
+        size_t ring_capacity = 8192;
+
+        // Elastic sizing (SharedQueue only). 'threads' is the starting size;
+        // every resize_interval the pool compares the measured queue wait
+        // (average wait of dequeued tasks, or the age of the oldest queued
+        // task if larger) against the thresholds. Above grow_wait it adds a
+        // worker; below shrink_wait with idle workers for shrink_after
+        // consecutive intervals it retires one.
+        bool elastic = false;
+        size_t min_threads = 1;
+        size_t max_threads = 0;  // 0 = 'threads'
+        std::chrono::microseconds grow_wait{2000};
+        std::chrono::microseconds shrink_wait{200};
+        std::chrono::milliseconds resize_interval{100};
+        size_t shrink_after = 10;
+
+        // Idle strategy. With both budgets zero an idle worker parks on the
+        // condition variable at once. Otherwise it first spins with CPU pause
+        // instructions for idle_spin, then yields for idle_yield, and only
+        // then parks; work arriving meanwhile starts without a futex wake.
+        // Buys wake-up latency with idle CPU time.
+        std::chrono::microseconds idle_spin{0};
+        std::chrono::microseconds idle_yield{0};
+
+        // Record per-task queue wait (enqueue -> dequeue) and run time into
+        // per-worker histograms, read with task_timings(). Costs three TSC
+        // reads and a few uncontended stores per task; ignored when built
+        // with THREAD_POOL_TIMING=0.
+        bool record_timings = false;
+    };
+
+    // task_timings() histograms: bucket i counts durations below
+    // timing_bucket_bound_ns(i) (and at least half of it); the last bucket
+    // is open-ended
+    static constexpr size_t kTimingBuckets = 32;
+
+    struct TimingHistogram
+    {
+        std::array<uint64_t, kTimingBuckets> buckets{};
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+    };
+
+    struct TaskTimings
     {
+        TimingHistogram queue_wait;
+        TimingHistogram run;
+    };
+
+    // Where one worker is allowed to run and where it was last seen
+    struct WorkerPlacement
+    {
+        size_t worker;
+        int node;               // -1 unless numa_aware
+        std::vector<int> cpus;  // Affinity mask; empty when not pinned
+        int last_cpu;           // CPU observed at start / after the last wake-up, -1 if unknown
+    };
+
+    ThreadPool(size_t n = std::thread::hardware_concurrency(),
+               SchedulingMode mode = SchedulingMode::SharedQueue)
+        : ThreadPool(make_options(n, mode))
+    {
+    }
+
+    explicit ThreadPool(const Options &opts)
+        : options(opts), done(false)
+    {
+        size_t n = options.threads;
         if (n == 0)
             n = 1;
+        if (options.high_priority_weight == 0)
+            options.high_priority_weight = 1;
+        options.elastic = options.elastic && options.mode == SchedulingMode::SharedQueue;
+        size_t slots = n;
+        if (options.elastic)
+        {
+            options.max_threads = std::max(options.max_threads, n);
+            options.min_threads = std::min(std::max<size_t>(options.min_threads, 1), n);
+            slots = options.max_threads;
+        }
+        plan_placement(slots);
+        if (options.elastic || timing_enabled())
+            TaskClock::ns_per_tick();  // Calibrate now, not on the first task
+#if THREAD_POOL_TIMING
+        if (timing_enabled())
+            timings.reset(new WorkerTimings[slots]());
+#endif
+        if (options.mode == SchedulingMode::WorkStealing)
+        {
+            for (size_t i = 0; i < n; ++i)
+                local_queues.emplace_back(std::make_unique<WorkerQueue>());
+        }
+        else if (options.mode == SchedulingMode::LockFreeRing)
+        {
+            size_t ring = std::max<size_t>(options.ring_capacity, 1);
+            rings[lane(TaskPriority::High)] = std::make_unique<MpmcRing<QueuedTask>>(ring);
+            rings[lane(TaskPriority::Normal)] = std::make_unique<MpmcRing<QueuedTask>>(
+                options.capacity > 0 ? options.capacity : ring);
+        }
+        workers.resize(slots);
         for (size_t i = 0; i < n; ++i)
-            workers.emplace_back([this]
-                                 { this->worker(); });
+            start_worker(i);
+        for (size_t i = slots; i-- > n;)
+            free_slots.push_back(i);
+        if (options.elastic)
+            monitor = std::thread([this]
+                                  { elastic_monitor(); });
     }
 
     // Disable copy constructor and assignment
     ThreadPool(const ThreadPool&) = delete;
     ThreadPool& operator=(const ThreadPool&) = delete;
-    
+
     // Enable move constructor and assignment
-    ThreadPool(ThreadPool&& other) noexcept 
-        : workers(std::move(other.workers)),
+    ThreadPool(ThreadPool&& other) noexcept
+        : options(other.options),
+          workers(std::move(other.workers)),
+          monitor(std::move(other.monitor)),
+          free_slots(std::move(other.free_slots)),
+          retired_slots(std::move(other.retired_slots)),
           tasks(std::move(other.tasks)),
+          local_queues(std::move(other.local_queues)),
+          priority_tasks(std::move(other.priority_tasks)),
+          rings(std::move(other.rings)),
+          worker_cpus(std::move(other.worker_cpus)),
+          worker_node(std::move(other.worker_node)),
+          steal_order(std::move(other.steal_order)),
+          last_cpu(std::move(other.last_cpu)),
+#if THREAD_POOL_TIMING
+          timings(std::move(other.timings)),
+#endif
           mtx(),  // Cannot move mutex
           cv(),   // Cannot move condition_variable
-          done(other.done.load())
+          done(other.done.load()),
+          pending(other.pending.load()),
+          priority_pending(other.priority_pending.load()),
+          normal_pending(other.normal_pending.load()),
+          live_workers(other.live_workers.load()),
+          heap_spilled(other.heap_spilled.load()),
+          rejected(other.rejected.load()),
+          dropped(other.dropped.load()),
+          blocked(other.blocked.load()),
+          expired(other.expired.load())
     {
         other.done = true; // Mark other as done
     }
-    
+
     ThreadPool& operator=(ThreadPool&& other) noexcept
     {
         if (this != &other) {
             shutdown(); // Shutdown current pool
+            options = other.options;
             workers = std::move(other.workers);
+            monitor = std::move(other.monitor);
+            free_slots = std::move(other.free_slots);
+            retired_slots = std::move(other.retired_slots);
             tasks = std::move(other.tasks);
+            local_queues = std::move(other.local_queues);
+            priority_tasks = std::move(other.priority_tasks);
+            rings = std::move(other.rings);
+            worker_cpus = std::move(other.worker_cpus);
+            worker_node = std::move(other.worker_node);
+            steal_order = std::move(other.steal_order);
+            last_cpu = std::move(other.last_cpu);
+#if THREAD_POOL_TIMING
+            timings = std::move(other.timings);
+#endif
             done = other.done.load();
+            pending = other.pending.load();
+            priority_pending = other.priority_pending.load();
+            normal_pending = other.normal_pending.load();
+            live_workers = other.live_workers.load();
+            heap_spilled = other.heap_spilled.load();
+            rejected = other.rejected.load();
+            dropped = other.dropped.load();
+            blocked = other.blocked.load();
+            expired = other.expired.load();
             other.done = true;
         }
         return *this;
@@ -58,8 +285,18 @@ public:
 
         try
         {
-            // Wake up all workers to check the done flag
+            // Wake up all workers to check the done flag. Taking the lock first
+            // guarantees no worker is between its predicate check and cv.wait().
+            {
+                std::lock_guard<std::mutex> lk(mtx);
+            }
             cv.notify_all();
+            not_full.notify_all(); // Blocked submitters give up
+
+            // Stop resizing before joining, so the worker set is final
+            monitor_cv.notify_all();
+            if (monitor.joinable())
+                monitor.join();
 
             for (auto &t : workers)
             {
@@ -74,69 +311,1165 @@ public:
             // Suppress all exceptions
         }
     }
+    // Returns false after shutdown, or when a bounded pool refuses the task
+    // under its OverflowPolicy. Tasks submitted here are never evicted.
     template <typename T>
-    bool submit(T &&task)
+    bool submit(T &&task, TaskPriority priority = TaskPriority::Normal)
     {
+        return enqueue(make_task(std::forward<T>(task), 0, false), priority);
+    }
+
+    // Like submit(), but returns a TaskFuture for the task's result or
+    // exception. then() continuations on it run on this pool. If the pool
+    // refuses the task, the future fails with std::runtime_error.
+    template <typename F>
+    auto submit_with_result(F &&task, TaskPriority priority = TaskPriority::Normal)
+        -> TaskFuture<std::invoke_result_t<std::decay_t<F>>>
+    {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        TaskPromise<Result> promise(this);
+        TaskFuture<Result> future = promise.get_future();
+        auto state = std::make_shared<TaskPromise<Result>>(std::move(promise));
+        bool accepted = submit([state, fn = std::forward<F>(task)]() mutable
+                               {
+            try
+            {
+                if constexpr (std::is_void_v<Result>)
+                {
+                    fn();
+                    state->set_value();
+                }
+                else
+                {
+                    state->set_value(fn());
+                }
+            }
+            catch (...)
+            {
+                state->set_exception(std::current_exception());
+            } },
+                               priority);
+        if (!accepted)
+            state->set_exception(std::make_exception_ptr(
+                std::runtime_error("ThreadPool refused task")));
+        return future;
+    }
+
+    // Like submit(), but a bounded pool may later evict the task to admit
+    // newer work (DropOldest, or DropNewestByKey when 'key' matches). Use for
+    // data-plane messages whose loss is preferable to unbounded queueing.
+    // Key 0 means "no key". An optional deadline works as in
+    // submit_with_deadline().
+    template <typename T>
+    bool submit_droppable(T &&task, size_t key = 0,
+                          TaskPriority priority = TaskPriority::Normal,
+                          Deadline deadline = kNoDeadline)
+    {
+        return enqueue(make_task(std::forward<T>(task), key, true, deadline), priority);
+    }
+
+    // Like submit(), but a task still queued at 'deadline' is dropped
+    // without running and counted in expired_tasks(). In SharedQueue mode
+    // each lane runs earliest-deadline-first: a task is queued behind every
+    // task with an earlier or equal deadline and ahead of later deadlines
+    // and of tasks without one (which keep FIFO order among themselves).
+    // WorkStealing and LockFreeRing keep their order and only drop
+    // expired tasks.
+    template <typename T>
+    bool submit_with_deadline(T &&task, Deadline deadline,
+                              TaskPriority priority = TaskPriority::Normal)
+    {
+        return enqueue(make_task(std::forward<T>(task), 0, false, deadline), priority);
+    }
+
+    // Enqueue every callable in 'range' with a single lock acquisition and
+    // wake at most one worker per task. Elements are moved out of the range.
+    // All-or-nothing: returns false (and runs nothing) after shutdown.
+    // A bounded pool applies its OverflowPolicy to the batch as a whole;
+    // DropNewestByKey rejects batches since they carry no key.
+    template <typename Range>
+    bool submit_batch(Range &&range, TaskPriority priority = TaskPriority::Normal)
+    {
+        std::vector<QueuedTask> batch;
+        for (auto &task : range)
+            batch.push_back(make_task(std::move(task), 0, false));
+        if (batch.empty())
+            return !done;
+
+        if (options.mode != SchedulingMode::SharedQueue)
+            return submit_batch_to_worker_queues(batch, priority);
+
         {
             std::unique_lock<std::mutex> lk(mtx);
             if (done) {
                 return false; // Don't accept new tasks after shutdown
             }
-            tasks.push(std::function<void()>(std::forward<T>(task)));
-            cv.notify_one();
-            return true;
+            if (priority == TaskPriority::Normal && !admit_shared(lk, batch.size(), 0))
+                return false;
+            for (auto &task : batch)
+                tasks[lane(priority)].push_back(std::move(task));
+            if (spins_when_idle())
+                shared_pushes.fetch_add(1, std::memory_order_relaxed);
         }
+        wake_workers(batch.size());
+        return true;
     }
 
     // Utility methods
-    size_t size() const { return workers.size(); }
-    
+    // Live workers; varies over time in elastic mode
+    size_t size() const { return live_workers.load(); }
+
+    SchedulingMode scheduling_mode() const { return options.mode; }
+
+    LanePolicy lane_policy() const { return options.lane_policy; }
+
     bool is_shutdown() const { return done.load(); }
-    
+
     size_t pending_tasks() const {
+        if (options.mode != SchedulingMode::SharedQueue)
+            return pending.load();
         std::unique_lock<std::mutex> lk(mtx);
-        return tasks.size();
+        return tasks[0].size() + tasks[1].size();
     }
-    
+
+    size_t capacity() const { return options.capacity; }
+
+    OverflowPolicy overflow_policy() const { return options.overflow; }
+
+    // Tasks waiting in one lane
+    size_t pending_tasks(TaskPriority priority) const {
+        if (options.mode != SchedulingMode::SharedQueue)
+            return priority == TaskPriority::High ? priority_pending.load() : normal_pending.load();
+        std::unique_lock<std::mutex> lk(mtx);
+        return tasks[lane(priority)].size();
+    }
+
     size_t active_threads() const {
         // Return number of worker threads (all threads are considered active)
-        return workers.size();
+        return live_workers.load();
+    }
+
+    bool is_elastic() const { return options.elastic; }
+
+    bool timing_enabled() const {
+#if THREAD_POOL_TIMING
+        return options.record_timings;
+#else
+        return false;
+#endif
+    }
+
+    static constexpr uint64_t timing_bucket_bound_ns(size_t bucket) {
+        return bucket + 1 >= kTimingBuckets ? UINT64_MAX : uint64_t(1) << bucket;
+    }
+
+    // Queue-wait and run-time histograms summed over all workers. Empty
+    // unless timing_enabled(). Counts are read without a lock, so a snapshot
+    // taken under load may be off by the tasks finishing meanwhile.
+    TaskTimings task_timings() const {
+        TaskTimings total;
+#if THREAD_POOL_TIMING
+        if (!timings)
+            return total;
+        auto add = [](TimingHistogram &into, const std::atomic<uint64_t> *buckets,
+                      const std::atomic<uint64_t> &sum_ns) {
+            for (size_t i = 0; i < kTimingBuckets; ++i)
+            {
+                const uint64_t n = buckets[i].load(std::memory_order_relaxed);
+                into.buckets[i] += n;
+                into.count += n;
+            }
+            into.sum_ns += sum_ns.load(std::memory_order_relaxed);
+        };
+        for (size_t i = 0; i < workers.size(); ++i)
+        {
+            add(total.queue_wait, timings[i].wait.data(), timings[i].wait_ns);
+            add(total.run, timings[i].run.data(), timings[i].run_ns);
+        }
+#endif
+        return total;
+    }
+
+    bool spins_when_idle() const {
+        return options.idle_spin.count() > 0 || options.idle_yield.count() > 0;
+    }
+
+    // Elastic mode: resize decisions taken so far, and the queue wait the
+    // last decision was based on
+    size_t grow_events() const { return grows.load(std::memory_order_relaxed); }
+    size_t shrink_events() const { return shrinks.load(std::memory_order_relaxed); }
+    std::chrono::microseconds measured_queue_wait() const {
+        return std::chrono::microseconds(last_wait_us.load(std::memory_order_relaxed));
+    }
+
+    // Number of submitted tasks whose captures did not fit InlineTask's
+    // inline buffer and therefore needed a heap allocation
+    size_t heap_spilled_tasks() const {
+        return heap_spilled.load(std::memory_order_relaxed);
+    }
+
+    // Tasks dropped unrun because their deadline passed while queued
+    size_t expired_tasks() const { return expired.load(std::memory_order_relaxed); }
+
+    // Admission-control counters (bounded pools only)
+    size_t rejected_tasks() const { return rejected.load(std::memory_order_relaxed); }
+    size_t dropped_tasks() const { return dropped.load(std::memory_order_relaxed); }
+    size_t blocked_submissions() const { return blocked.load(std::memory_order_relaxed); }
+
+    // Affinity, NUMA node and last observed CPU of every worker
+    std::vector<WorkerPlacement> worker_placement() const {
+        std::vector<WorkerPlacement> placement;
+        for (size_t i = 0; i < worker_cpus.size(); ++i)
+            placement.push_back({i, worker_node[i], worker_cpus[i],
+                                 last_cpu[i].load(std::memory_order_relaxed)});
+        return placement;
     }
 
 private:
+    // A queued task plus what admission control needs to evict it
+    struct QueuedTask
+    {
+        InlineTask task;
+        size_t key = 0;          // DropNewestByKey match, 0 = none
+        bool droppable = false;  // Submitted via submit_droppable()
+        uint64_t enqueued = 0;   // TaskClock ticks; stamped when elastic or timing
+        Deadline deadline = kNoDeadline;
+    };
+
+#if THREAD_POOL_TIMING
+    // Written only by the owning worker, so updates are plain relaxed
+    // load/store pairs rather than locked read-modify-writes
+    struct alignas(64) WorkerTimings
+    {
+        std::array<std::atomic<uint64_t>, kTimingBuckets> wait{};
+        std::array<std::atomic<uint64_t>, kTimingBuckets> run{};
+        std::atomic<uint64_t> wait_ns{0};
+        std::atomic<uint64_t> run_ns{0};
+    };
+
+    static void bump(std::atomic<uint64_t> &counter, uint64_t by)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    static size_t timing_bucket(uint64_t ns)
+    {
+        size_t bucket = ns == 0 ? 0 : 64 - static_cast<size_t>(__builtin_clzll(ns));
+        return std::min(bucket, kTimingBuckets - 1);
+    }
+#endif
+
+    // Deque owned by one worker in WorkStealing mode. Both the owner and
+    // thieves take from the front so arrival order is preserved as far as
+    // possible; the per-deque mutex is only contended while stealing.
+    struct WorkerQueue
+    {
+        std::mutex mtx;
+        std::deque<QueuedTask> tasks;
+    };
+
+    // Identifies the pool and deque owned by the calling thread, if any
+    static inline thread_local const ThreadPool* current_pool = nullptr;
+    static inline thread_local size_t current_index = 0;
+
+    static Options make_options(size_t n, SchedulingMode mode)
+    {
+        Options opts;
+        opts.threads = n;
+        opts.mode = mode;
+        return opts;
+    }
+
+    static constexpr size_t lane(TaskPriority priority)
+    {
+        return static_cast<size_t>(priority);
+    }
+
+    // Build the task outside any lock; only oversized captures allocate
+    template <typename T>
+    QueuedTask make_task(T &&task, size_t key, bool droppable, Deadline deadline = kNoDeadline)
+    {
+        QueuedTask queued{InlineTask(std::forward<T>(task)), key, droppable, 0, deadline};
+        if (options.elastic || timing_enabled())
+            queued.enqueued = TaskClock::now();
+        if (!queued.task.is_inline())
+            heap_spilled.fetch_add(1, std::memory_order_relaxed);
+        return queued;
+    }
+
+    bool enqueue(QueuedTask task, TaskPriority priority)
+    {
+        if (options.mode != SchedulingMode::SharedQueue)
+            return submit_to_worker_queue(std::move(task), priority);
+
+        {
+            std::unique_lock<std::mutex> lk(mtx);
+            if (done) {
+                return false; // Don't accept new tasks after shutdown
+            }
+            if (priority == TaskPriority::Normal && !admit_shared(lk, 1, task.key))
+                return false;
+            push_shared(tasks[lane(priority)], std::move(task));
+            if (spins_when_idle())
+                shared_pushes.fetch_add(1, std::memory_order_relaxed);
+            cv.notify_one();
+            return true;
+        }
+    }
+
+    // Make room for 'count' Normal tasks in SharedQueue mode; caller holds
+    // 'mtx'. A batch larger than the capacity is admitted into an empty queue.
+    bool admit_shared(std::unique_lock<std::mutex> &lk, size_t count, size_t key)
+    {
+        auto &normal = tasks[lane(TaskPriority::Normal)];
+        auto fits = [&]
+        { return normal.size() + count <= options.capacity || normal.empty(); };
+        if (options.capacity == 0 || fits())
+            return true;
+
+        bool admitted = false;
+        switch (options.overflow)
+        {
+        case OverflowPolicy::Block:
+            // A worker waiting for room could be the one meant to make it
+            if (current_pool == this)
+                return true;
+            blocked.fetch_add(1, std::memory_order_relaxed);
+            waiting_submitters.fetch_add(1);
+            not_full.wait(lk, [&]
+                          { return done || fits(); });
+            waiting_submitters.fetch_sub(1);
+            return !done;
+        case OverflowPolicy::DropOldest:
+            admitted = evict_shared(normal.size() + count - options.capacity, 0);
+            break;
+        case OverflowPolicy::DropNewestByKey:
+            admitted = key != 0 && evict_shared(normal.size() + count - options.capacity, key);
+            break;
+        case OverflowPolicy::Reject:
+            break;
+        }
+        if (!admitted)
+            rejected.fetch_add(count, std::memory_order_relaxed);
+        return admitted;
+    }
+
+    // Evict up to 'needed' droppable Normal tasks: the least urgent ones, or
+    // with a key the newest ones carrying that key. Caller holds 'mtx'.
+    bool evict_shared(size_t needed, size_t key)
+    {
+        auto &normal = tasks[lane(TaskPriority::Normal)];
+        needed = std::min(needed, normal.size());
+        size_t evicted = 0;
+        if (key == 0)
+        {
+            // The lane is dated tasks by deadline, then undated ones in
+            // arrival order. Undated tasks go first, oldest first, then dated
+            // ones latest deadline first, so EDF never evicts the tasks that
+            // can still meet their deadline. Without deadlines this is plain
+            // oldest-first.
+            const size_t undated = static_cast<size_t>(
+                std::partition_point(normal.begin(), normal.end(),
+                                     [](const QueuedTask &t)
+                                     { return t.deadline != kNoDeadline; }) -
+                normal.begin());
+            for (auto it = normal.begin() + undated; it != normal.end() && evicted < needed;)
+            {
+                if (!it->droppable) { ++it; continue; }
+                it = normal.erase(it);
+                ++evicted;
+            }
+            for (size_t i = undated; i-- > 0 && evicted < needed;)
+            {
+                if (normal[i].droppable)
+                {
+                    normal.erase(normal.begin() + i);
+                    ++evicted;
+                }
+            }
+        }
+        else
+        {
+            for (size_t i = normal.size(); i-- > 0 && evicted < needed;)
+            {
+                if (normal[i].droppable && normal[i].key == key)
+                {
+                    normal.erase(normal.begin() + i);
+                    ++evicted;
+                }
+            }
+        }
+        dropped.fetch_add(evicted, std::memory_order_relaxed);
+        return evicted == needed;
+    }
+
+    // Reserve 'count' Normal slots in WorkStealing and LockFreeRing mode
+    // ('normal_pending' is the reservation counter), applying the overflow
+    // policy when full.
+    bool admit_stealing(size_t count, size_t key)
+    {
+        if (options.capacity == 0)
+        {
+            normal_pending.fetch_add(count);
+            return true;
+        }
+        bool waited = false;
+        while (true)
+        {
+            size_t queued = normal_pending.load();
+            if (queued + count <= options.capacity || queued == 0 ||
+                (options.overflow == OverflowPolicy::Block && current_pool == this))
+            {
+                if (normal_pending.compare_exchange_weak(queued, queued + count))
+                    return true;
+                continue;
+            }
+
+            bool retry = false;
+            switch (options.overflow)
+            {
+            case OverflowPolicy::Block:
+            {
+                if (!waited)
+                    blocked.fetch_add(1, std::memory_order_relaxed);
+                waited = true;
+                std::unique_lock<std::mutex> lk(mtx);
+                waiting_submitters.fetch_add(1);
+                not_full.wait(lk, [&]
+                              {
+                    size_t now = normal_pending.load();
+                    return done || now + count <= options.capacity || now == 0; });
+                waiting_submitters.fetch_sub(1);
+                if (done)
+                    return false;
+                retry = true;
+                break;
+            }
+            case OverflowPolicy::DropOldest:
+                retry = options.mode == SchedulingMode::WorkStealing && evict_stealing(0);
+                break;
+            case OverflowPolicy::DropNewestByKey:
+                retry = options.mode == SchedulingMode::WorkStealing && key != 0 && evict_stealing(key);
+                break;
+            case OverflowPolicy::Reject:
+                break;
+            }
+            if (!retry)
+            {
+                rejected.fetch_add(count, std::memory_order_relaxed);
+                return false;
+            }
+        }
+    }
+
+    // Evict one droppable Normal task from the worker deques: the front-most
+    // droppable one, or with a key the newest carrying that key.
+    bool evict_stealing(size_t key)
+    {
+        const size_t n = local_queues.size();
+        const size_t first = next_queue.load(std::memory_order_relaxed);
+        for (size_t q = 0; q < n; ++q)
+        {
+            auto &queue = *local_queues[(first + q) % n];
+            std::lock_guard<std::mutex> lk(queue.mtx);
+            auto match = [key](const QueuedTask &t)
+            { return t.droppable && (key == 0 || t.key == key); };
+            auto victim = queue.tasks.end();
+            if (key == 0)
+                victim = std::find_if(queue.tasks.begin(), queue.tasks.end(), match);
+            else
+            {
+                auto rit = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(), match);
+                if (rit != queue.tasks.rend())
+                    victim = std::prev(rit.base());
+            }
+            if (victim == queue.tasks.end())
+                continue;
+            queue.tasks.erase(victim);
+            pending.fetch_sub(1);
+            normal_pending.fetch_sub(1);
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    // A Normal task left the queue: let one blocked submitter in
+    // (SharedQueue callers hold 'mtx')
+    void normal_slot_freed()
+    {
+        if (options.mode != SchedulingMode::SharedQueue)
+            normal_pending.fetch_sub(1);
+        if (options.capacity == 0)
+            return;
+        if (waiting_submitters.load() > 0)
+        {
+            if (options.mode != SchedulingMode::SharedQueue)
+            {
+                std::lock_guard<std::mutex> lk(mtx);
+            }
+            not_full.notify_all();
+        }
+    }
+
+    // Decide each worker's affinity, node and steal order before any
+    // thread starts, so workers only read this state.
+    void plan_placement(size_t n)
+    {
+        worker_cpus.assign(n, {});
+        worker_node.assign(n, -1);
+        last_cpu.reset(new std::atomic<int>[n]);
+        for (size_t i = 0; i < n; ++i)
+            last_cpu[i].store(-1, std::memory_order_relaxed);
+
+        if (options.numa_aware)
+        {
+            std::vector<std::vector<int>> nodes;
+            std::vector<int> node_ids;
+            auto topology = CpuTopology::numa_nodes();
+            for (size_t id = 0; id < topology.size(); ++id)
+            {
+                std::vector<int> cpus;
+                for (int cpu : topology[id])
+                    if (options.cpu_list.empty() ||
+                        std::find(options.cpu_list.begin(), options.cpu_list.end(), cpu) != options.cpu_list.end())
+                        cpus.push_back(cpu);
+                if (!cpus.empty())
+                {
+                    nodes.push_back(std::move(cpus));
+                    node_ids.push_back(static_cast<int>(id));
+                }
+            }
+            // Contiguous blocks of workers per node: 0..k on node A, k+1.. on node B
+            for (size_t i = 0; i < n && !nodes.empty(); ++i)
+            {
+                size_t node = i * nodes.size() / n;
+                worker_cpus[i] = nodes[node];
+                worker_node[i] = node_ids[node];
+            }
+        }
+        else if (!options.cpu_list.empty())
+        {
+            for (size_t i = 0; i < n; ++i)
+                worker_cpus[i] = {options.cpu_list[i % options.cpu_list.size()]};
+        }
+
+        if (options.mode != SchedulingMode::WorkStealing)
+            return;
+        // Victims on the thief's own node come first, in ring order
+        steal_order.assign(n, {});
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t offset = 1; offset < n; ++offset)
+                if (worker_node[(i + offset) % n] == worker_node[i])
+                    steal_order[i].push_back((i + offset) % n);
+            for (size_t offset = 1; offset < n; ++offset)
+                if (worker_node[(i + offset) % n] != worker_node[i])
+                    steal_order[i].push_back((i + offset) % n);
+        }
+    }
+
+    static void cpu_relax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    // Idle strategy: spin, then yield, until 'ready()' or the budgets run
+    // out. Returns whether 'ready()' became true.
+    template <typename Ready>
+    bool spin_then_yield(Ready ready) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto spin_until = start + options.idle_spin;
+        const auto yield_until = spin_until + options.idle_yield;
+        auto now = start;
+        for (unsigned spins = 0;; ++spins)
+        {
+            if (ready())
+                return true;
+            if (now < spin_until)
+            {
+                cpu_relax();
+                if (spins % 64 == 63)  // Amortize the clock read over a few pauses
+                    now = std::chrono::steady_clock::now();
+            }
+            else if (now < yield_until)
+            {
+                std::this_thread::yield();
+                now = std::chrono::steady_clock::now();
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+
+    void start_worker(size_t index)
+    {
+        live_workers.fetch_add(1);
+        workers[index] = std::thread([this, index]
+                                     { this->worker(index); });
+    }
+
+    // Elastic: accumulate the queue wait of a task being dequeued; caller holds 'mtx'
+    void record_wait(const QueuedTask &queued)
+    {
+        window_wait_ns += TaskClock::elapsed_ns(queued.enqueued, TaskClock::now());
+        ++window_dequeues;
+    }
+
+    // Enqueue stamp of the task that has waited longest in a non-empty
+    // SharedQueue lane. An undated front means the lane holds no deadlines
+    // and is in arrival order; otherwise EDF has reordered it, and a late or
+    // undated task may have waited longer than the front, so scan it (once
+    // per resize_interval). Caller holds 'mtx'.
+    static uint64_t oldest_enqueued(const std::deque<QueuedTask> &lane_tasks)
+    {
+        if (lane_tasks.front().deadline == kNoDeadline)
+            return lane_tasks.front().enqueued;
+        uint64_t oldest = lane_tasks.front().enqueued;
+        for (const auto &queued : lane_tasks)
+            oldest = std::min(oldest, queued.enqueued);
+        return oldest;
+    }
+
+    // Elastic sizing loop; one decision per resize_interval
+    void elastic_monitor()
+    {
+        std::unique_lock<std::mutex> lk(mtx);
+        size_t quiet_intervals = 0;
+        while (!done)
+        {
+            monitor_cv.wait_for(lk, options.resize_interval, [&]
+                                { return done.load(); });
+            if (done)
+                break;
+
+            // Reap retired workers so their slots can be reused
+            for (size_t slot : retired_slots)
+            {
+                if (workers[slot].joinable())
+                    workers[slot].join();
+                free_slots.push_back(slot);
+            }
+            retired_slots.clear();
+
+            // Signal: average wait of this interval's dequeues, or the age of
+            // the oldest queued task when workers are too busy to dequeue
+            const uint64_t now = TaskClock::now();
+            uint64_t wait_ns = window_dequeues > 0 ? window_wait_ns / window_dequeues : 0;
+            for (auto &lane_tasks : tasks)
+                if (!lane_tasks.empty())
+                    wait_ns = std::max(wait_ns, TaskClock::elapsed_ns(oldest_enqueued(lane_tasks), now));
+            window_wait_ns = 0;
+            window_dequeues = 0;
+            const std::chrono::nanoseconds wait(wait_ns);
+            last_wait_us.store(std::chrono::duration_cast<std::chrono::microseconds>(wait).count(),
+                               std::memory_order_relaxed);
+
+            const size_t live = live_workers.load() - retire_requests;
+            if (wait > options.grow_wait && live < options.max_threads && !free_slots.empty())
+            {
+                grows.fetch_add(1, std::memory_order_relaxed);
+                quiet_intervals = 0;
+                if (retire_requests > 0)
+                    --retire_requests;  // Cancel a pending shrink first
+                else
+                {
+                    size_t slot = free_slots.back();
+                    free_slots.pop_back();
+                    start_worker(slot);
+                }
+            }
+            else if (wait < options.shrink_wait && idle_shared > 0 && live > options.min_threads)
+            {
+                if (++quiet_intervals >= options.shrink_after)
+                {
+                    shrinks.fetch_add(1, std::memory_order_relaxed);
+                    quiet_intervals = 0;
+                    ++retire_requests;
+                    cv.notify_one();
+                }
+            }
+            else
+            {
+                quiet_intervals = 0;
+            }
+        }
+    }
+
+    void note_cpu(size_t index)
+    {
+        last_cpu[index].store(CpuTopology::current_cpu(), std::memory_order_relaxed);
+    }
+
+    void worker(size_t index)
+    {
+        // Pinning failures (e.g. CPUs outside our cpuset) leave the worker floating
+        if (!worker_cpus[index].empty())
+            CpuTopology::pin_current_thread(worker_cpus[index]);
+        note_cpu(index);
+        current_pool = this;
+        current_index = index;
+
+        if (options.mode == SchedulingMode::SharedQueue)
+            shared_worker(index);
+        else
+            stealing_worker(index);
+    }
+
+    // Queue 'task' on a SharedQueue lane, keeping the lane sorted by
+    // deadline (kNoDeadline sorts last, so undated tasks stay FIFO and pay
+    // only a compare); caller holds 'mtx'
+    static void push_shared(std::deque<QueuedTask> &queue, QueuedTask &&task)
+    {
+        if (queue.empty() || queue.back().deadline <= task.deadline)
+        {
+            queue.push_back(std::move(task));
+            return;
+        }
+        auto later = std::upper_bound(queue.begin(), queue.end(), task.deadline,
+                                      [](Deadline deadline, const QueuedTask &queued)
+                                      { return deadline < queued.deadline; });
+        queue.insert(later, std::move(task));
+    }
+
+    bool has_shared_tasks() const
+    {
+        return !tasks[0].empty() || !tasks[1].empty();
+    }
+
+    // Pick the next task from the shared lanes; caller holds 'mtx'.
+    // Weighted mode caps consecutive High tasks while Normal work waits so
+    // the data plane cannot be starved by a flood of control messages.
+    bool pop_shared(QueuedTask &task)
+    {
+        auto &high = tasks[lane(TaskPriority::High)];
+        auto &normal = tasks[lane(TaskPriority::Normal)];
+        bool take_high = !high.empty() &&
+                         (normal.empty() ||
+                          options.lane_policy == LanePolicy::Strict ||
+                          high_streak < options.high_priority_weight);
+        if (take_high)
+        {
+            ++high_streak;
+            if (options.elastic)
+                record_wait(high.front());
+            task = std::move(high.front());
+            high.pop_front();
+            return true;
+        }
+        if (normal.empty())
+            return false;
+        high_streak = 0;
+        if (options.elastic)
+            record_wait(normal.front());
+        task = std::move(normal.front());
+        normal.pop_front();
+        normal_slot_freed();
+        return true;
+    }
+
     // Worker loop: waits for tasks or shutdown signal.
-    // The wait predicate 'done || !tasks.empty()' is safe because:
-    // - If 'done' is true and the queue is empty, the worker exits.
+    // The wait predicate 'done || has_shared_tasks()' is safe because:
+    // - If 'done' is true and the queues are empty, the worker exits.
     // - If there are tasks, the worker processes them.
     // - Spurious wakeups are handled by re-checking the predicate.
-    void worker()
+    void shared_worker(size_t index)
     {
         while (true)
         {
-            std::function<void()> task;
+            QueuedTask task;
             {
                 std::unique_lock<std::mutex> lk(mtx);
+                if (spins_when_idle() && !done && !has_shared_tasks())
+                {
+                    // Watch for new pushes without holding the lock
+                    const size_t seen = shared_pushes.load(std::memory_order_relaxed);
+                    lk.unlock();
+                    spin_then_yield([&]
+                                    { return shared_pushes.load(std::memory_order_relaxed) != seen ||
+                                             done.load(std::memory_order_relaxed); });
+                    lk.lock();
+                }
+                bool parked = !done && !has_shared_tasks();
+                ++idle_shared;
                 cv.wait(lk, [&]
-                        { return done || !tasks.empty(); });
-                if (done && tasks.empty())
+                        { return done || has_shared_tasks() || retire_requests > 0; });
+                --idle_shared;
+                if (parked)
+                    note_cpu(index);
+                if (done && !has_shared_tasks())
                     break;
+                if (retire_requests > 0 && !done && !has_shared_tasks())
+                {
+                    // Elastic shrink: hand the slot back to the monitor
+                    --retire_requests;
+                    live_workers.fetch_sub(1);
+                    retired_slots.push_back(index);
+                    return;
+                }
                 // Simplified: if we're here and not done, there must be tasks
-                task = std::move(tasks.front());
-                tasks.pop();
+                pop_shared(task);
             }
-            // Execute task with exception safety
-            try {
-                task();
-            } catch (...) {
-                // Log error in production, but don't let exceptions kill the worker
-                // Could integrate with your logging framework here
+            run(index, task);
+        }
+    }
+
+    // Work-stealing loop: take High-lane work from the shared priority deque,
+    // then drain the local deque, then steal from peers, and only park on the
+    // shared condition variable when nothing is pending. LockFreeRing workers
+    // run the same loop with the two rings standing in for the deques.
+    // 'pending' is raised before a task is pushed and lowered after it is
+    // popped, so 'done && pending == 0' means every accepted task has run.
+    void stealing_worker(size_t index)
+    {
+        size_t streak = 0;
+
+        while (true)
+        {
+            QueuedTask task;
+            bool high_allowed = options.lane_policy == LanePolicy::Strict ||
+                                streak < options.high_priority_weight;
+            bool found = false;
+            if (high_allowed && pop_priority(task))
+            {
+                ++streak;
+                found = true;
+            }
+            else if (pop_local(index, task) || steal(index, task))
+            {
+                streak = 0;
+                found = true;
+                normal_slot_freed();
+            }
+            else if (pop_priority(task))
+            {
+                ++streak;
+                found = true;
+            }
+
+            if (found)
+            {
+                pending.fetch_sub(1);
+                run(index, task);
+                continue;
+            }
+
+            // Work is in flight (being pushed, or its deque was busy): retry
+            if (pending.load() > 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (spins_when_idle())
+            {
+                spin_then_yield([&]
+                                { return pending.load(std::memory_order_relaxed) > 0 ||
+                                         done.load(std::memory_order_relaxed); });
+                if (pending.load() > 0)
+                    continue;
+            }
+
+            std::unique_lock<std::mutex> lk(mtx);
+            idle_workers.fetch_add(1);
+            cv.wait(lk, [&]
+                    { return done || pending.load() > 0; });
+            idle_workers.fetch_sub(1);
+            if (done && pending.load() == 0)
+                break;
+            note_cpu(index);
+        }
+    }
+
+    bool submit_to_worker_queue(QueuedTask task, TaskPriority priority)
+    {
+        const bool normal = priority == TaskPriority::Normal;
+        if (normal && !admit_stealing(1, task.key))
+            return false;
+
+        // Count the task before checking 'done' so a concurrent shutdown
+        // either sees it pending or we see the shutdown and back out.
+        pending.fetch_add(1);
+        if (done) {
+            pending.fetch_sub(1);
+            if (normal)
+                normal_pending.fetch_sub(1);
+            return false; // Don't accept new tasks after shutdown
+        }
+
+        if (options.mode == SchedulingMode::LockFreeRing)
+        {
+            if (!push_ring(task, priority))
+                return true;  // Ran inline on this worker
+        }
+        else if (!normal)
+        {
+            // Control-plane work is rare; one shared deque keeps it visible
+            // to every worker instead of hiding it behind a busy peer.
+            std::lock_guard<std::mutex> lk(priority_mtx);
+            priority_tasks.push_back(std::move(task));
+            priority_pending.fetch_add(1);
+        }
+        else
+        {
+            // Tasks submitted from one of our workers stay on its own deque;
+            // external submissions are spread round-robin.
+            size_t index = current_pool == this
+                               ? current_index
+                               : next_queue.fetch_add(1, std::memory_order_relaxed) % local_queues.size();
+            std::lock_guard<std::mutex> lk(local_queues[index]->mtx);
+            local_queues[index]->tasks.push_back(std::move(task));
+        }
+
+        // Only pay for the futex wake when somebody is actually parked.
+        if (idle_workers.load() > 0)
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            cv.notify_one();
+        }
+        return true;
+    }
+
+    bool submit_batch_to_worker_queues(std::vector<QueuedTask> &batch, TaskPriority priority)
+    {
+        const size_t count = batch.size();
+        const bool normal = priority == TaskPriority::Normal;
+        if (normal && !admit_stealing(count, 0))
+            return false;
+
+        pending.fetch_add(count);
+        if (done) {
+            pending.fetch_sub(count);
+            if (normal)
+                normal_pending.fetch_sub(count);
+            return false; // Don't accept new tasks after shutdown
+        }
+
+        if (options.mode == SchedulingMode::LockFreeRing)
+        {
+            for (auto &task : batch)
+                push_ring(task, priority);
+        }
+        else if (!normal)
+        {
+            std::lock_guard<std::mutex> lk(priority_mtx);
+            for (auto &task : batch)
+                priority_tasks.push_back(std::move(task));
+            priority_pending.fetch_add(count);
+        }
+        else if (current_pool == this)
+        {
+            // Whole batch stays on the submitting worker's deque; peers steal
+            std::lock_guard<std::mutex> lk(local_queues[current_index]->mtx);
+            for (auto &task : batch)
+                local_queues[current_index]->tasks.push_back(std::move(task));
+        }
+        else
+        {
+            // One contiguous slice per deque, one lock per deque touched
+            const size_t queues = local_queues.size();
+            const size_t first = next_queue.fetch_add(1, std::memory_order_relaxed);
+            const size_t slice = (count + queues - 1) / queues;
+            for (size_t begin = 0, q = 0; begin < count; begin += slice, ++q)
+            {
+                auto &queue = *local_queues[(first + q) % queues];
+                std::lock_guard<std::mutex> lk(queue.mtx);
+                for (size_t i = begin; i < std::min(begin + slice, count); ++i)
+                    queue.tasks.push_back(std::move(batch[i]));
+            }
+        }
+
+        if (idle_workers.load() > 0)
+            wake_workers(count);
+        return true;
+    }
+
+    void wake_workers(size_t count)
+    {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+        }
+        if (count >= workers.size())
+        {
+            cv.notify_all();
+            return;
+        }
+        for (size_t i = 0; i < count; ++i)
+            cv.notify_one();
+    }
+
+    // Push one already-counted task onto its LockFreeRing lane. A full ring
+    // makes an external submitter yield until a worker frees a slot; a
+    // worker cannot wait on its own peers, so it takes the task back out of
+    // the counters and runs it here. Returns false in that case.
+    bool push_ring(QueuedTask &task, TaskPriority priority)
+    {
+        const bool normal = priority == TaskPriority::Normal;
+        auto &ring = *rings[lane(priority)];
+        if (!normal)
+            priority_pending.fetch_add(1);
+        while (!ring.try_push(std::move(task)))
+        {
+            if (current_pool != this)
+            {
+                std::this_thread::yield();
+                continue;
             }
+            if (normal)
+                normal_slot_freed();
+            else
+                priority_pending.fetch_sub(1);
+            pending.fetch_sub(1);
+            run(current_index, task);
+            return false;
         }
+        return true;
     }
 
-    std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
+    bool pop_priority(QueuedTask &task)
+    {
+        if (priority_pending.load() == 0)
+            return false;
+        if (options.mode == SchedulingMode::LockFreeRing)
+        {
+            if (!rings[lane(TaskPriority::High)]->try_pop(task))
+                return false;
+            priority_pending.fetch_sub(1);
+            return true;
+        }
+        std::lock_guard<std::mutex> lk(priority_mtx);
+        if (priority_tasks.empty())
+            return false;
+        task = std::move(priority_tasks.front());
+        priority_tasks.pop_front();
+        priority_pending.fetch_sub(1);
+        return true;
+    }
+
+    bool pop_local(size_t index, QueuedTask &task)
+    {
+        if (options.mode == SchedulingMode::LockFreeRing)
+            return rings[lane(TaskPriority::Normal)]->try_pop(task);
+        auto &queue = *local_queues[index];
+        std::lock_guard<std::mutex> lk(queue.mtx);
+        if (queue.tasks.empty())
+            return false;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    bool steal(size_t index, QueuedTask &task)
+    {
+        if (options.mode == SchedulingMode::LockFreeRing)
+            return false;  // Every worker already pops from the same ring
+        for (size_t victim_index : steal_order[index])
+        {
+            auto &victim = *local_queues[victim_index];
+            // A busy victim is skipped; the caller re-checks 'pending' before parking.
+            std::unique_lock<std::mutex> lk(victim.mtx, std::try_to_lock);
+            if (!lk.owns_lock() || victim.tasks.empty())
+                continue;
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void run(size_t index, QueuedTask &queued)
+    {
+        if (queued.deadline != kNoDeadline && std::chrono::steady_clock::now() > queued.deadline)
+        {
+            expired.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+#if THREAD_POOL_TIMING
+        if (timing_enabled())
+        {
+            const uint64_t start = TaskClock::now();
+            run(queued.task);
+            const uint64_t end = TaskClock::now();
+            auto &slot = timings[index];
+            const uint64_t wait_ns = TaskClock::elapsed_ns(queued.enqueued, start);
+            const uint64_t run_ns = TaskClock::elapsed_ns(start, end);
+            bump(slot.wait[timing_bucket(wait_ns)], 1);
+            bump(slot.wait_ns, wait_ns);
+            bump(slot.run[timing_bucket(run_ns)], 1);
+            bump(slot.run_ns, run_ns);
+            return;
+        }
+#endif
+        run(queued.task);
+    }
+
+    static void run(InlineTask &task)
+    {
+        // Execute task with exception safety
+        try {
+            task();
+        } catch (...) {
+            // Log error in production, but don't let exceptions kill the worker
+            // Could integrate with your logging framework here
+        }
+    }
+
+    Options options;
+    std::vector<std::thread> workers;  // Indexed by worker slot; empty slots are not joinable
+    std::thread monitor;               // Elastic sizing loop
+    std::vector<size_t> free_slots;    // Elastic: slots without a live worker, guarded by 'mtx'
+    std::vector<size_t> retired_slots; // Elastic: exited workers awaiting join, guarded by 'mtx'
+    std::array<std::deque<QueuedTask>, kLaneCount> tasks;  // SharedQueue lanes, indexed by TaskPriority
+    std::vector<std::unique_ptr<WorkerQueue>> local_queues;
+    std::deque<QueuedTask> priority_tasks;  // WorkStealing High lane
+    std::array<std::unique_ptr<MpmcRing<QueuedTask>>, kLaneCount> rings;  // LockFreeRing lanes
+    std::mutex priority_mtx;
+    std::vector<std::vector<int>> worker_cpus;      // Affinity per worker, empty = floating
+    std::vector<int> worker_node;                   // NUMA node per worker, -1 if not numa_aware
+    std::vector<std::vector<size_t>> steal_order;   // WorkStealing victims per worker
+    std::unique_ptr<std::atomic<int>[]> last_cpu;   // Reported by worker_placement()
+#if THREAD_POOL_TIMING
+    std::unique_ptr<WorkerTimings[]> timings;       // One per worker slot when timing_enabled()
+#endif
     mutable std::mutex mtx;
     std::condition_variable cv;
+    std::condition_variable not_full;  // Block policy: submitters wait here on 'mtx'
+    std::condition_variable monitor_cv;
     std::atomic<bool> done;
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> priority_pending{0};
+    std::atomic<size_t> normal_pending{0};      // WorkStealing Normal lane, incl. reserved slots
+    std::atomic<size_t> live_workers{0};
+    std::atomic<size_t> shared_pushes{0};       // SharedQueue pushes, watched by spinning workers
+    std::atomic<size_t> idle_workers{0};
+    std::atomic<size_t> waiting_submitters{0};
+    std::atomic<size_t> next_queue{0};
+    std::atomic<size_t> heap_spilled{0};
+    std::atomic<size_t> rejected{0};
+    std::atomic<size_t> dropped{0};
+    std::atomic<size_t> blocked{0};
+    std::atomic<size_t> expired{0};
+    size_t high_streak = 0;  // SharedQueue Weighted policy, guarded by 'mtx'
+    // Elastic state, guarded by 'mtx'
+    size_t idle_shared = 0;
+    size_t retire_requests = 0;
+    size_t window_dequeues = 0;
+    uint64_t window_wait_ns = 0;
+    std::atomic<size_t> grows{0};
+    std::atomic<size_t> shrinks{0};
+    std::atomic<int64_t> last_wait_us{0};
 };
+
+inline bool task_future_detail::post(ThreadPool &pool, InlineTask &&task)
+{
+    return pool.submit(std::move(task));
+}
@@ -24,7 +24,7 @@ public:
     ~PortfolioManager() = default;
     
     // 🚀 NEW: Start infrastructure asynchronously
-    std::future<void> start_infrastructure_async() {
+    TaskFuture<void> start_infrastructure_async() {
         // Create configuration for portfolio service
         auto config = ServiceHost::create_production_config();
         
@@ -43,7 +43,7 @@ public:
     }
     
     // 🚀 NEW: Complete service startup after infrastructure is ready
-    void complete_startup(std::future<void>&& infrastructure_future) {
+    void complete_startup(TaskFuture<void>&& infrastructure_future) {
         try {
             // Wait for infrastructure to be ready
             infrastructure_future.get();
@@ -151,7 +151,9 @@ private:
     // Setup handlers during construction
     void _setup_handlers() {
         // Register handlers using ServiceHost's register_message method
-        service_host_->register_message<Trevor::HealthCheckRequest>(
+        // Answered on the request's reply subject (request<HealthCheckRequest,
+        // HealthCheckResponse>); plain publishes still get a point-to-point reply
+        service_host_->register_request_handler<Trevor::HealthCheckRequest, Trevor::HealthCheckResponse>(
             MessageRouting::PointToPoint,
             [this](const Trevor::HealthCheckRequest& req) {
                 service_host_->get_logger()->info("📋 Received HealthCheckRequest from service: {}, UID: {}", 
@@ -162,8 +164,10 @@ private:
                 res.set_service_name("PortfolioManager");
                 res.set_uid(service_host_->get_uid());
                 res.set_status(service_host_->get_status());
-                
-                // Send response
+                return res;
+            },
+            TaskPriority::High,  // Answer health checks even while market data is backed up
+            [this](const Trevor::HealthCheckRequest& req, const Trevor::HealthCheckResponse& res) {
                 service_host_->publish_point_to_point(req.uid(), res);
                 service_host_->get_logger()->info("✅ Sent HealthCheckResponse to: {}", req.uid());
             }
@@ -187,7 +191,9 @@ private:
                 // Send response
                 service_host_->publish_point_to_point(req.requester_uid(), res);
                 service_host_->get_logger()->info("✅ Sent PortfolioResponse for account: {}", req.account_id());
-            }
+            },
+            // Requests for one account are handled in arrival order; accounts run in parallel
+            [](const Trevor::PortfolioRequest& req) { return req.account_id(); }
         );
         
         service_host_->register_message<Trevor::MarketDataUpdate>(
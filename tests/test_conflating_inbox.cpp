@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "libs/common/conflating_inbox.hpp"
+#include "libs/common/thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// While a key's task runs, newer submissions replace each other; only the
+// latest one runs after it
+TEST(ConflatingInboxTest, KeepsOnlyLatestPendingPerKey) {
+    ThreadPool pool(2);
+    ConflatingInbox inbox(pool);
+
+    std::promise<void> started;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::mutex mtx;
+    std::vector<int> seen;
+
+    inbox.submit("AAPL", [&]() {
+        started.set_value();
+        released.wait();
+        std::lock_guard<std::mutex> lk(mtx);
+        seen.push_back(0);
+    });
+    started.get_future().wait();
+    for (int i = 1; i <= 5; ++i) {
+        inbox.submit("AAPL", [&, i]() {
+            std::lock_guard<std::mutex> lk(mtx);
+            seen.push_back(i);
+        });
+    }
+    release.set_value();
+    pool.shutdown();
+
+    EXPECT_EQ(seen, (std::vector<int>{0, 5}));
+    EXPECT_EQ(inbox.conflated(), 4u);
+    EXPECT_EQ(inbox.active_keys(), 0u);
+}
+
+// Keys never conflate with each other, and each key's last update always runs
+TEST(ConflatingInboxTest, LastUpdatePerKeyAlwaysRuns) {
+    ThreadPool pool(4);
+    ConflatingInbox inbox(pool);
+
+    const int keys = 16;
+    const int per_key = 1000;
+    std::mutex mtx;
+    std::map<std::string, std::vector<int>> seen;
+    std::map<std::string, std::atomic<int>> in_flight;
+    std::atomic<bool> overlapped{false};
+    for (int k = 0; k < keys; ++k) {
+        in_flight["SYM" + std::to_string(k)];
+    }
+
+    for (int i = 0; i < per_key; ++i) {
+        for (int k = 0; k < keys; ++k) {
+            std::string key = "SYM" + std::to_string(k);
+            std::atomic<int>* running = &in_flight[key];
+            EXPECT_TRUE(inbox.submit(key, [&, running, key, i]() {
+                if (running->fetch_add(1) != 0) {
+                    overlapped = true;
+                }
+                {
+                    std::lock_guard<std::mutex> lk(mtx);
+                    seen[key].push_back(i);
+                }
+                running->fetch_sub(1);
+            }));
+        }
+    }
+    pool.shutdown();
+
+    EXPECT_FALSE(overlapped.load());
+    ASSERT_EQ(seen.size(), static_cast<size_t>(keys));
+    size_t ran = 0;
+    for (auto& [key, order] : seen) {
+        ASSERT_FALSE(order.empty());
+        EXPECT_EQ(order.back(), per_key - 1) << key;
+        for (size_t i = 1; i < order.size(); ++i) {
+            EXPECT_LT(order[i - 1], order[i]) << key;  // Never an older update after a newer one
+        }
+        ran += order.size();
+    }
+    EXPECT_EQ(ran + inbox.conflated(), static_cast<size_t>(keys * per_key));
+}
+
+TEST(ConflatingInboxTest, RejectsAfterShutdown) {
+    ThreadPool pool(1);
+    ConflatingInbox inbox(pool);
+    pool.shutdown();
+    EXPECT_FALSE(inbox.submit("AAPL", []() {}));
+}
+
+// A refused update is reported but kept: once the pool has room it runs,
+// even though no newer update for its key ever arrives
+TEST(ConflatingInboxTest, RefusedLastUpdateStillRuns) {
+    ThreadPool::Options options;
+    options.threads = 1;
+    options.capacity = 1;
+    options.overflow = ThreadPool::OverflowPolicy::Reject;
+    ThreadPool pool(options);
+    ConflatingInbox inbox(pool);
+
+    std::promise<void> started;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    ASSERT_TRUE(pool.submit([&started, released]() {
+        started.set_value();
+        released.wait();
+    }));
+    started.get_future().wait();
+    ASSERT_TRUE(pool.submit([]() {}));  // Queue is now full
+
+    std::mutex mtx;
+    std::vector<std::string> ran;
+    auto update = [&](std::string name) {
+        return [&, name]() {
+            std::lock_guard<std::mutex> lk(mtx);
+            ran.push_back(name);
+        };
+    };
+    EXPECT_FALSE(inbox.submit("AAPL", update("AAPL last")));
+    EXPECT_EQ(inbox.refused(), 1u);
+    EXPECT_EQ(inbox.active_keys(), 1u);  // Still pending
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        EXPECT_TRUE(ran.empty());  // Not run on the submitting thread
+    }
+
+    // AAPL goes quiet; traffic on another symbol gives it its retry
+    release.set_value();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!inbox.submit("MSFT", update("MSFT")) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    pool.shutdown();
+
+    std::lock_guard<std::mutex> lk(mtx);
+    EXPECT_EQ(std::count(ran.begin(), ran.end(), "AAPL last"), 1);
+    EXPECT_GE(std::count(ran.begin(), ran.end(), "MSFT"), 1);
+    EXPECT_EQ(inbox.active_keys(), 0u);
+}
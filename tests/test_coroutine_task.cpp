@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "libs/common/coroutine_task.hpp"
+#include "libs/common/logger.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+CoTask<std::thread::id> worker_id(ThreadPool& pool) {
+    co_await schedule_on(pool);
+    co_return std::this_thread::get_id();
+}
+
+CoTask<int> add(int a, int b) {
+    co_return a + b;
+}
+
+CoTask<int> sum_of_sums() {
+    int first = co_await add(1, 2);
+    int second = co_await add(first, 4);
+    co_return second;
+}
+
+CoTask<int> fails() {
+    throw std::runtime_error("boom");
+    co_return 0;
+}
+
+CoTask<int> catches() {
+    try {
+        co_await fails();
+    } catch (const std::runtime_error&) {
+        co_return -1;
+    }
+    co_return 0;
+}
+
+} // namespace
+
+// co_spawn hops onto a worker; schedule_on moves there from anywhere
+TEST(CoroutineTaskTest, ScheduleOnPool) {
+    ThreadPool pool(2);
+    auto id = co_spawn(pool, worker_id(pool));
+    EXPECT_NE(id.get(), std::this_thread::get_id());
+}
+
+// Awaited CoTasks hand back values and exceptions
+TEST(CoroutineTaskTest, NestedTasks) {
+    ThreadPool pool(2);
+    EXPECT_EQ(co_spawn(pool, sum_of_sums()).get(), 7);
+    EXPECT_EQ(co_spawn(pool, catches()).get(), -1);
+    EXPECT_THROW(co_spawn(pool, fails()).get(), std::runtime_error);
+}
+
+// A TaskFuture is awaitable; its exception is rethrown in the coroutine
+TEST(CoroutineTaskTest, AwaitTaskFuture) {
+    ThreadPool pool(2);
+    auto await_both = [](ThreadPool& pool) -> CoTask<int> {
+        int value = co_await pool.submit_with_result([]() { return 40; });
+        try {
+            co_await pool.submit_with_result([]() -> int { throw std::runtime_error("boom"); });
+        } catch (const std::runtime_error&) {
+            value += 2;
+        }
+        co_return value;
+    };
+    EXPECT_EQ(co_spawn(pool, await_both(pool)).get(), 42);
+}
+
+// co_detach runs inline up to the first suspension, then finishes on the pool
+TEST(CoroutineTaskTest, DetachRunsInlineUntilSuspended) {
+    ThreadPool pool(1);
+    std::atomic<int> stage{0};
+    auto steps = [](ThreadPool& pool, std::atomic<int>& stage) -> CoTask<void> {
+        stage = 1;
+        co_await schedule_on(pool);
+        stage = 2;
+    };
+    co_detach(steps(pool, stage));
+    EXPECT_GE(stage.load(), 1);
+    pool.shutdown();
+    EXPECT_EQ(stage.load(), 2);
+}
+
+// Many coroutines wait on scheduler timers at once without holding the two
+// workers: 500 x 50 ms of sleeping finishes in about 50 ms, not 12.5 s
+TEST(CoroutineTaskTest, TimersDoNotHoldWorkers) {
+    ThreadPool pool(2);
+    Logger::set_level(Logger::Level::WARN);
+    ServiceScheduler scheduler(&pool, std::make_shared<Logger>("coroutine_test"));
+    scheduler.start();
+
+    constexpr int kCoroutines = 500;
+    std::atomic<int> done{0};
+    auto sleeper = [](ServiceScheduler& scheduler, std::atomic<int>& done) -> CoTask<void> {
+        co_await resume_after(scheduler, std::chrono::milliseconds(50));
+        done.fetch_add(1);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<TaskFuture<void>> futures;
+    for (int i = 0; i < kCoroutines; ++i) {
+        futures.push_back(co_spawn(pool, sleeper(scheduler, done)));
+    }
+    when_all(futures).get();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(done.load(), kCoroutines);
+    EXPECT_LT(elapsed, std::chrono::seconds(5));
+    scheduler.stop();
+}
+
+// A timer never strands its coroutine: a stopped scheduler continues it at
+// once, and stop() resumes coroutines still waiting on a timer
+TEST(CoroutineTaskTest, TimersResumeWhenSchedulerStops) {
+    ThreadPool pool(2);
+    Logger::set_level(Logger::Level::WARN);
+    ServiceScheduler scheduler(&pool, std::make_shared<Logger>("coroutine_test"));
+    auto sleeper = [](ServiceScheduler& scheduler) -> CoTask<int> {
+        co_await resume_after(scheduler, std::chrono::seconds(60));
+        co_return 1;
+    };
+
+    auto never_started = co_spawn(pool, sleeper(scheduler));
+    ASSERT_TRUE(never_started.wait_for(std::chrono::seconds(5)));
+    EXPECT_EQ(never_started.get(), 1);
+
+    scheduler.start();
+    std::vector<TaskFuture<int>> waiting;
+    for (int i = 0; i < 10; ++i) {
+        waiting.push_back(co_spawn(pool, sleeper(scheduler)));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    scheduler.stop();
+    for (auto& future : waiting) {
+        ASSERT_TRUE(future.wait_for(std::chrono::seconds(5)));
+        EXPECT_EQ(future.get(), 1);
+    }
+}
@@ -0,0 +1,184 @@
+// JetStreamConsumer tests against a real server. They need a local
+// nats-server with JetStream enabled (nats-server -js), at NATS_URL or
+// nats://localhost:4222, and are skipped when none is reachable.
+#include <gtest/gtest.h>
+#include "libs/common/jetstream_consumer.hpp"
+#include "libs/common/logger.hpp"
+#include "libs/common/thread_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+class JetStreamConsumerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const char* url = std::getenv("NATS_URL");
+        if (natsConnection_ConnectTo(&conn_, url ? url : "nats://localhost:4222") != NATS_OK) {
+            conn_ = nullptr;
+            GTEST_SKIP() << "No NATS server reachable";
+        }
+        if (natsConnection_JetStream(&js_, conn_, nullptr) != NATS_OK) {
+            js_ = nullptr;
+            GTEST_SKIP() << "JetStream not available";
+        }
+
+        // A stream of our own, so runs do not see each other's messages
+        const std::string suffix = std::to_string(getpid()) + "_" +
+                                   ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        stream_ = "SH_TEST_" + suffix;
+        subject_ = "test.jetstream." + suffix;
+        const char* subjects[] = {subject_.c_str()};
+        jsStreamConfig cfg;
+        jsStreamConfig_Init(&cfg);
+        cfg.Name = stream_.c_str();
+        cfg.Subjects = subjects;
+        cfg.SubjectsLen = 1;
+        jsStreamInfo* info = nullptr;
+        jsErrCode jerr = static_cast<jsErrCode>(0);
+        if (js_AddStream(&info, js_, &cfg, nullptr, &jerr) != NATS_OK) {
+            GTEST_SKIP() << "Cannot create stream (js error " << static_cast<int>(jerr) << ")";
+        }
+        jsStreamInfo_Destroy(info);
+        stream_created_ = true;
+    }
+
+    void TearDown() override {
+        if (stream_created_) {
+            js_DeleteStream(js_, stream_.c_str(), nullptr, nullptr);
+        }
+        if (js_) {
+            jsCtx_Destroy(js_);
+        }
+        if (conn_) {
+            natsConnection_Destroy(conn_);
+        }
+    }
+
+    void publish(int count) {
+        for (int i = 0; i < count; ++i) {
+            const std::string payload = std::to_string(i);
+            ASSERT_EQ(natsConnection_Publish(conn_, subject_.c_str(), payload.data(),
+                                             static_cast<int>(payload.size())),
+                      NATS_OK);
+        }
+        ASSERT_EQ(natsConnection_Flush(conn_), NATS_OK);
+    }
+
+    JetStreamConsumer::Options options(size_t batch) const {
+        JetStreamConsumer::Options opts;
+        opts.subject = subject_;
+        opts.stream = stream_;
+        opts.durable = "durable_" + stream_;
+        opts.fetch_batch = batch;
+        opts.fetch_timeout = std::chrono::milliseconds(100);
+        return opts;
+    }
+
+    template <typename Predicate>
+    static bool wait_for(Predicate done) {
+        auto start = std::chrono::steady_clock::now();
+        while (!done()) {
+            if (std::chrono::steady_clock::now() - start > std::chrono::seconds(10)) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    }
+
+    natsConnection* conn_ = nullptr;
+    jsCtx* js_ = nullptr;
+    std::string stream_;
+    std::string subject_;
+    bool stream_created_ = false;
+    std::shared_ptr<Logger> logger_ = std::make_shared<Logger>("JetStreamConsumerTest");
+};
+
+// Every message is handled once and acked, with no more than the window unacked
+TEST_F(JetStreamConsumerTest, AcksEachMessageAfterItsHandler) {
+    const int count = 500;
+    publish(count);
+
+    ThreadPool pool(4);
+    std::mutex mtx;
+    std::set<std::string> seen;
+    std::atomic<size_t> peak{0};
+    std::unique_ptr<JetStreamConsumer> consumer;
+    JetStreamConsumer::Options opts = options(32);
+    opts.max_in_flight = 64;
+    consumer = std::make_unique<JetStreamConsumer>(js_, pool, opts, [&](const MessageBuffer& payload) {
+        size_t now = consumer->in_flight();
+        size_t prev = peak.load();
+        while (now > prev && !peak.compare_exchange_weak(prev, now)) {
+        }
+        std::lock_guard<std::mutex> lk(mtx);
+        seen.emplace(payload.view());
+        return true;
+    }, logger_);
+    ASSERT_TRUE(consumer->start());
+
+    EXPECT_TRUE(wait_for([&]() { return consumer->acked() == static_cast<size_t>(count); }));
+    consumer->stop();
+
+    EXPECT_EQ(seen.size(), static_cast<size_t>(count));
+    EXPECT_EQ(consumer->nacked(), 0u);
+    EXPECT_EQ(consumer->in_flight(), 0u);
+    EXPECT_LE(peak.load(), consumer->max_in_flight());
+}
+
+// A failed or throwing handler naks its message and gets it again
+TEST_F(JetStreamConsumerTest, RedeliversNakedMessages) {
+    publish(20);
+
+    ThreadPool pool(2);
+    std::atomic<int> attempts_7{0};
+    std::atomic<int> attempts_9{0};
+    std::atomic<int> handled{0};
+    JetStreamConsumer consumer(js_, pool, options(8), [&](const MessageBuffer& payload) {
+        if (payload.view() == "7" && attempts_7.fetch_add(1) == 0) {
+            return false;
+        }
+        if (payload.view() == "9" && attempts_9.fetch_add(1) == 0) {
+            throw std::runtime_error("transient failure");
+        }
+        handled.fetch_add(1);
+        return true;
+    }, logger_);
+    ASSERT_TRUE(consumer.start());
+
+    EXPECT_TRUE(wait_for([&]() { return handled.load() == 20; }));
+    consumer.stop();
+
+    EXPECT_EQ(attempts_7.load(), 2);
+    EXPECT_EQ(attempts_9.load(), 2);
+    EXPECT_EQ(consumer.nacked(), 2u);
+    EXPECT_EQ(consumer.acked(), 20u);
+}
+
+// The durable consumer outlives its subscription: a second one resumes
+TEST_F(JetStreamConsumerTest, DurableResumesAfterRestart) {
+    publish(10);
+    ThreadPool pool(2);
+    std::atomic<int> handled{0};
+    auto count = [&](const MessageBuffer&) {
+        handled.fetch_add(1);
+        return true;
+    };
+    {
+        JetStreamConsumer first(js_, pool, options(4), count, logger_);
+        ASSERT_TRUE(first.start());
+        EXPECT_TRUE(wait_for([&]() { return first.acked() == 10; }));
+    }
+
+    publish(5);
+    JetStreamConsumer second(js_, pool, options(4), count, logger_);
+    ASSERT_TRUE(second.start());
+    EXPECT_TRUE(wait_for([&]() { return second.acked() == 5; }));
+    second.stop();
+    EXPECT_EQ(handled.load(), 15);
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include "libs/common/keyed_executor.hpp"
+#include "libs/common/thread_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class KeyedExecutorTest : public ::testing::TestWithParam<ThreadPool::SchedulingMode> {
+};
+
+// Tasks with the same key run in submission order, one at a time
+TEST_P(KeyedExecutorTest, PreservesPerKeyOrder) {
+    ThreadPool pool(4, GetParam());
+    KeyedExecutor strands(pool);
+
+    const int keys = 8;
+    const int per_key = 500;  // More than kDrainBurst, so drains resubmit
+    std::mutex mtx;
+    std::map<std::string, std::vector<int>> seen;
+    std::map<std::string, std::atomic<int>> in_flight;
+    std::atomic<bool> overlapped{false};
+    for (int k = 0; k < keys; ++k) {
+        in_flight["account-" + std::to_string(k)];
+    }
+
+    for (int i = 0; i < per_key; ++i) {
+        for (int k = 0; k < keys; ++k) {
+            std::string key = "account-" + std::to_string(k);
+            std::atomic<int>* running = &in_flight[key];
+            EXPECT_TRUE(strands.submit(key, [&, running, key, i]() {
+                if (running->fetch_add(1) != 0) {
+                    overlapped = true;
+                }
+                {
+                    std::lock_guard<std::mutex> lk(mtx);
+                    seen[key].push_back(i);
+                }
+                running->fetch_sub(1);
+            }));
+        }
+    }
+
+    pool.shutdown();
+
+    EXPECT_FALSE(overlapped.load());
+    ASSERT_EQ(seen.size(), static_cast<size_t>(keys));
+    for (auto& [key, order] : seen) {
+        ASSERT_EQ(order.size(), static_cast<size_t>(per_key)) << key;
+        for (int i = 0; i < per_key; ++i) {
+            EXPECT_EQ(order[i], i) << key;
+        }
+    }
+    EXPECT_EQ(strands.active_keys(), 0u);
+}
+
+// A blocked key does not hold up other keys
+TEST_P(KeyedExecutorTest, KeysRunInParallel) {
+    ThreadPool pool(2, GetParam());
+    KeyedExecutor strands(pool);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> other_done{0};
+
+    strands.submit("slow", [released]() { released.wait(); });
+    strands.submit("slow", [&other_done]() { other_done.fetch_add(100); });
+    for (int i = 0; i < 10; ++i) {
+        strands.submit("fast", [&other_done]() { other_done.fetch_add(1); });
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (other_done.load() < 10 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(other_done.load(), 10);  // "slow" follow-up still queued behind its key
+
+    release.set_value();
+    pool.shutdown();
+    EXPECT_EQ(other_done.load(), 110);
+}
+
+// Exceptions do not stall the key; submissions after shutdown are rejected
+TEST_P(KeyedExecutorTest, ExceptionsAndShutdown) {
+    ThreadPool pool(2, GetParam());
+    KeyedExecutor strands(pool);
+    std::atomic<int> counter{0};
+
+    strands.submit("k", []() { throw std::runtime_error("boom"); });
+    strands.submit("k", [&counter]() { counter.fetch_add(1); });
+
+    pool.shutdown();
+    EXPECT_EQ(counter.load(), 1);
+    EXPECT_FALSE(strands.submit("k", [&counter]() { counter.fetch_add(1); }));
+    EXPECT_EQ(counter.load(), 1);
+}
+
+// A bounded pool that refuses the drain rejects the task instead of running
+// it on the submitting thread
+TEST_P(KeyedExecutorTest, RefusedDrainRejectsTask) {
+    ThreadPool::Options options;
+    options.threads = 1;
+    options.mode = GetParam();
+    options.capacity = 1;
+    options.overflow = ThreadPool::OverflowPolicy::Reject;
+    ThreadPool pool(options);
+    KeyedExecutor strands(pool);
+
+    std::promise<void> started;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    ASSERT_TRUE(pool.submit([&started, released]() {
+        started.set_value();
+        released.wait();
+    }));
+    started.get_future().wait();
+    ASSERT_TRUE(pool.submit([]() {}));  // Queue is now full
+
+    std::atomic<int> counter{0};
+    const auto caller = std::this_thread::get_id();
+    std::atomic<bool> ran_on_caller{false};
+    EXPECT_FALSE(strands.submit("k", [&]() {
+        ran_on_caller = std::this_thread::get_id() == caller;
+        counter.fetch_add(1);
+    }));
+    EXPECT_EQ(strands.rejected(), 1u);
+    EXPECT_EQ(strands.active_keys(), 0u);
+    EXPECT_EQ(counter.load(), 0);
+
+    release.set_value();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    bool accepted = false;
+    while (!accepted && std::chrono::steady_clock::now() < deadline) {
+        accepted = strands.submit("k", [&counter]() { counter.fetch_add(1); });
+    }
+    EXPECT_TRUE(accepted);
+    pool.shutdown();
+    EXPECT_EQ(counter.load(), 1);
+    EXPECT_FALSE(ran_on_caller.load());
+}
+
+// Two submitters race on one key while the pool refuses drains: every
+// task whose submit() returned true still runs, once and in order
+TEST_P(KeyedExecutorTest, RefusedDrainKeepsAcceptedTasks) {
+    for (int round = 0; round < 50; ++round) {
+        ThreadPool::Options options;
+        options.threads = 1;
+        options.mode = GetParam();
+        options.capacity = 1;
+        options.overflow = ThreadPool::OverflowPolicy::Reject;
+        ThreadPool pool(options);
+        KeyedExecutor strands(pool);
+
+        std::promise<void> started;
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        ASSERT_TRUE(pool.submit([&started, released]() {
+            started.set_value();
+            released.wait();
+        }));
+        started.get_future().wait();
+        ASSERT_TRUE(pool.submit([]() {}));  // Queue is now full
+
+        const int per_submitter = 200;
+        std::mutex mtx;
+        std::vector<int> ran;
+        std::vector<int> accepted[2];
+        auto submitter = [&](int id) {
+            for (int i = 0; i < per_submitter; ++i) {
+                const int value = id * per_submitter + i;
+                if (strands.submit("account", [&mtx, &ran, value]() {
+                        std::lock_guard<std::mutex> lk(mtx);
+                        ran.push_back(value);
+                    })) {
+                    accepted[id].push_back(value);
+                }
+            }
+        };
+        std::thread first(submitter, 0);
+        std::thread second(submitter, 1);
+        first.join();
+        second.join();
+        EXPECT_EQ(strands.rejected() + accepted[0].size() + accepted[1].size(),
+                  static_cast<size_t>(2 * per_submitter));
+
+        // Free the pool; submits for another key retry the parked one
+        release.set_value();
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!strands.submit("other", []() {}) && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        pool.shutdown();
+
+        std::vector<int> from[2];
+        for (int value : ran) {
+            from[value / per_submitter].push_back(value);
+        }
+        EXPECT_EQ(from[0], accepted[0]);
+        EXPECT_EQ(from[1], accepted[1]);
+        EXPECT_EQ(strands.active_keys(), 0u);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(SchedulingModes, KeyedExecutorTest,
+                         ::testing::Values(ThreadPool::SchedulingMode::SharedQueue,
+                                           ThreadPool::SchedulingMode::WorkStealing,
+                                           ThreadPool::SchedulingMode::LockFreeRing));
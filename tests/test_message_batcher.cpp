@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "libs/common/message_batcher.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = MessageBatcher::Clock;
+
+// Records dispatched batches
+struct Harness {
+    std::vector<std::vector<std::string>> batches;
+    std::shared_ptr<MessageBatcher> batcher;
+
+    Harness(size_t max_batch, std::chrono::milliseconds max_delay) {
+        batcher = std::make_shared<MessageBatcher>(
+            max_batch, max_delay,
+            [this](MessageBatcher::Batch&& batch) {
+                std::vector<std::string> payloads;
+                for (const auto& buffer : batch) {
+                    payloads.emplace_back(buffer.view());
+                }
+                batches.push_back(std::move(payloads));
+            });
+    }
+
+    void add(const std::string& payload) { batcher->add(MessageBuffer::copy_of(payload)); }
+};
+
+} // namespace
+
+TEST(MessageBatcherTest, DispatchesFullBatch) {
+    Harness h(3, std::chrono::milliseconds(1000));
+    h.add("a");
+    h.add("b");
+    EXPECT_TRUE(h.batches.empty());
+    h.add("c");
+    ASSERT_EQ(h.batches.size(), 1u);
+    EXPECT_EQ(h.batches[0], (std::vector<std::string>{"a", "b", "c"}));
+}
+
+// The periodic check sends a partial batch only once it is max_delay old
+TEST(MessageBatcherTest, FlushIfDueSendsOverduePartialBatch) {
+    Harness h(10, std::chrono::milliseconds(1000));
+    h.batcher->flush_if_due(Clock::now() + std::chrono::seconds(5));
+    EXPECT_TRUE(h.batches.empty());  // Nothing pending
+
+    h.add("a");
+    h.add("b");
+    h.batcher->flush_if_due();
+    EXPECT_TRUE(h.batches.empty());  // Not due yet
+    h.batcher->flush_if_due(Clock::now() + std::chrono::milliseconds(1000));
+    ASSERT_EQ(h.batches.size(), 1u);
+    EXPECT_EQ(h.batches[0], (std::vector<std::string>{"a", "b"}));
+}
+
+// A new batch is timed from its own first message, not the previous batch's
+TEST(MessageBatcherTest, NextBatchTimedFromItsFirstMessage) {
+    Harness h(2, std::chrono::milliseconds(1000));
+    h.add("a");
+    h.add("b");
+    ASSERT_EQ(h.batches.size(), 1u);
+    const auto after_first = Clock::now();
+    h.add("c");
+    h.batcher->flush_if_due(after_first);
+    EXPECT_EQ(h.batches.size(), 1u);
+    h.batcher->flush_if_due(Clock::now() + std::chrono::milliseconds(1000));
+    ASSERT_EQ(h.batches.size(), 2u);
+    EXPECT_EQ(h.batches[1], (std::vector<std::string>{"c"}));
+}
+
+TEST(MessageBatcherTest, OverdueBatchGoesOutOnNextAdd) {
+    Harness h(100, std::chrono::milliseconds(0));
+    h.add("a");
+    ASSERT_EQ(h.batches.size(), 1u);
+}
+
+TEST(MessageBatcherTest, FlushDrainsPendingBatch) {
+    Harness h(10, std::chrono::milliseconds(1000));
+    h.batcher->flush();
+    EXPECT_TRUE(h.batches.empty());
+    h.add("a");
+    h.batcher->flush();
+    ASSERT_EQ(h.batches.size(), 1u);
+    EXPECT_EQ(h.batches[0], (std::vector<std::string>{"a"}));
+}
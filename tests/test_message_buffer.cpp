@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "libs/common/message_buffer.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+natsMsg* make_msg(const std::string& payload) {
+    natsMsg* msg = nullptr;
+    EXPECT_EQ(natsMsg_Create(&msg, "system.broadcast.Test", nullptr, payload.data(),
+                             static_cast<int>(payload.size())),
+              NATS_OK);
+    return msg;
+}
+
+} // namespace
+
+// The view points into the natsMsg itself: no copy of the payload
+TEST(MessageBufferTest, AdoptViewsNatsPayload) {
+    natsMsg* msg = make_msg("hello");
+    MessageBuffer buffer = MessageBuffer::adopt(msg);
+    EXPECT_EQ(buffer.view(), "hello");
+    EXPECT_EQ(buffer.data(), natsMsg_GetData(msg));
+    EXPECT_EQ(buffer.size(), 5u);
+}
+
+// Copies share the message; it stays valid until the last one is gone
+TEST(MessageBufferTest, CopiesKeepMessageAlive) {
+    const std::string payload(4096, 'x');
+    MessageBuffer copy;
+    {
+        MessageBuffer original = MessageBuffer::adopt(make_msg(payload));
+        copy = original;
+        EXPECT_EQ(copy.data(), original.data());
+    }
+    EXPECT_EQ(copy.view(), payload);
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([held = copy, &payload]() { EXPECT_EQ(held.view(), payload); });
+    }
+    copy = MessageBuffer();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+}
+
+TEST(MessageBufferTest, CopyOfOwnsItsBytes) {
+    std::string payload = "abc";
+    MessageBuffer buffer = MessageBuffer::copy_of(payload);
+    payload[0] = 'z';
+    EXPECT_EQ(buffer.view(), "abc");
+    EXPECT_TRUE(MessageBuffer().empty());
+}
+
+// The reply subject survives with the message; none for plain publishes
+TEST(MessageBufferTest, ExposesReplySubject) {
+    natsMsg* msg = nullptr;
+    ASSERT_EQ(natsMsg_Create(&msg, "system.direct.svc.Test", "_INBOX.abc.7", "x", 1), NATS_OK);
+    MessageBuffer request = MessageBuffer::adopt(msg);
+    EXPECT_EQ(request.reply(), "_INBOX.abc.7");
+
+    EXPECT_TRUE(MessageBuffer::adopt(make_msg("y")).reply().empty());
+    EXPECT_TRUE(MessageBuffer::copy_of("z").reply().empty());
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "libs/common/mpmc_ring.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Capacity rounds up to a power of two; push fails when full, pop when empty
+TEST(MpmcRingTest, FullAndEmpty) {
+    MpmcRing<int> ring(3);
+    EXPECT_EQ(ring.capacity(), 4u);
+
+    int value = 0;
+    EXPECT_FALSE(ring.try_pop(value));
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(99));
+    EXPECT_EQ(ring.size_approx(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+}
+
+// FIFO order holds across many laps of the cell array
+TEST(MpmcRingTest, WrapsAround) {
+    MpmcRing<int> ring(4);
+    int next = 0;
+    for (int lap = 0; lap < 100; ++lap) {
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_TRUE(ring.try_push(lap * 3 + i));
+        }
+        int value = -1;
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_TRUE(ring.try_pop(value));
+            EXPECT_EQ(value, next++);
+        }
+    }
+}
+
+// Move-only elements; a failed push leaves the argument intact, and the
+// destructor releases whatever is still queued
+TEST(MpmcRingTest, MoveOnlyElements) {
+    auto tracked = std::make_shared<int>(7);
+    {
+        MpmcRing<std::unique_ptr<std::shared_ptr<int>>> ring(2);
+        EXPECT_TRUE(ring.try_push(std::make_unique<std::shared_ptr<int>>(tracked)));
+        EXPECT_TRUE(ring.try_push(std::make_unique<std::shared_ptr<int>>(tracked)));
+
+        auto extra = std::make_unique<std::shared_ptr<int>>(tracked);
+        EXPECT_FALSE(ring.try_push(std::move(extra)));
+        EXPECT_NE(extra, nullptr);
+        EXPECT_EQ(tracked.use_count(), 4);
+    }
+    EXPECT_EQ(tracked.use_count(), 1);
+}
+
+// Every pushed value is popped exactly once under concurrent producers and consumers
+TEST(MpmcRingTest, ConcurrentProducersAndConsumers) {
+    constexpr int kProducers = 4;
+    constexpr int kConsumers = 4;
+    constexpr int kPerProducer = 20000;
+    MpmcRing<int> ring(64);
+
+    std::vector<std::atomic<int>> seen(kProducers * kPerProducer);
+    std::atomic<int> consumed{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&ring, p]() {
+            for (int i = 0; i < kPerProducer; ++i) {
+                while (!ring.try_push(p * kPerProducer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&]() {
+            int value;
+            while (consumed.load() < kProducers * kPerProducer) {
+                if (ring.try_pop(value)) {
+                    seen[value].fetch_add(1);
+                    consumed.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(consumed.load(), kProducers * kPerProducer);
+    for (const auto& count : seen) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
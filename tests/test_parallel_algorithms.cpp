@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "libs/common/parallel_algorithms.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const ThreadPool::SchedulingMode kAllModes[] = {
+    ThreadPool::SchedulingMode::SharedQueue,
+    ThreadPool::SchedulingMode::WorkStealing,
+    ThreadPool::SchedulingMode::LockFreeRing,
+};
+
+} // namespace
+
+// Every index is visited exactly once, in every scheduling mode and grain
+TEST(ParallelAlgorithmsTest, ForVisitsEachIndexOnce) {
+    for (auto mode : kAllModes) {
+        ThreadPool pool(4, mode);
+        for (size_t grain : {size_t{0}, size_t{1}, size_t{1000}}) {
+            std::vector<std::atomic<int>> hits(100000);
+            parallel_for(pool, size_t{0}, hits.size(), [&](size_t i) { hits[i].fetch_add(1); }, grain);
+            for (auto& hit : hits) {
+                ASSERT_EQ(hit.load(), 1);
+            }
+        }
+    }
+}
+
+// Signed and empty ranges
+TEST(ParallelAlgorithmsTest, ForSignedAndEmptyRanges) {
+    ThreadPool pool(2);
+    std::atomic<long> sum{0};
+    parallel_for(pool, -500, 500, [&](int i) { sum.fetch_add(i); });
+    EXPECT_EQ(sum.load(), -500);
+
+    bool called = false;
+    parallel_for(pool, 10, 10, [&](int) { called = true; });
+    parallel_for(pool, 10, 5, [&](int) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST(ParallelAlgorithmsTest, TransformReduce) {
+    ThreadPool pool(4);
+    std::vector<int64_t> values(1 << 20);
+    std::iota(values.begin(), values.end(), 1);
+    const int64_t n = static_cast<int64_t>(values.size());
+
+    int64_t sum_of_squares = parallel_transform_reduce(
+        pool, values.begin(), values.end(), int64_t{0}, std::plus<>(),
+        [](int64_t v) { return v * v; });
+    EXPECT_EQ(sum_of_squares, n * (n + 1) * (2 * n + 1) / 6);
+
+    int64_t max_value = parallel_transform_reduce(
+        pool, values.begin(), values.end(), int64_t{0},
+        [](int64_t a, int64_t b) { return std::max(a, b); }, [](int64_t v) { return v; });
+    EXPECT_EQ(max_value, n);
+
+    std::vector<int64_t> empty;
+    EXPECT_EQ(parallel_transform_reduce(pool, empty.begin(), empty.end(), int64_t{7},
+                                        std::plus<>(), [](int64_t v) { return v; }),
+              7);
+}
+
+TEST(ParallelAlgorithmsTest, SortMatchesStdSort) {
+    ThreadPool pool(4);
+    std::mt19937 rng(42);
+    for (size_t size : {size_t{0}, size_t{100}, kParallelSortCutoff, size_t{300001}}) {
+        std::vector<uint32_t> values(size);
+        for (auto& value : values) {
+            value = rng() % 1000;  // Plenty of duplicates
+        }
+        std::vector<uint32_t> expected = values;
+        std::sort(expected.begin(), expected.end(), std::greater<>());
+        parallel_sort(pool, values.begin(), values.end(), std::greater<>());
+        EXPECT_EQ(values, expected) << "size " << size;
+    }
+}
+
+// Nested calls from every worker of a small pool complete: callers run
+// chunks themselves instead of blocking on queued helpers
+TEST(ParallelAlgorithmsTest, NestedCallsFromWorkersDoNotDeadlock) {
+    for (auto mode : kAllModes) {
+        ThreadPool pool(2, mode);
+        std::vector<size_t> ones(1000, 1);
+        std::atomic<size_t> total{0};
+        parallel_for(pool, 0, 8, [&](int) {
+            total.fetch_add(parallel_transform_reduce(pool, ones.begin(), ones.end(), size_t{0},
+                                                      std::plus<>(), [](size_t v) { return v; }, 1));
+            parallel_for(pool, 0, 1000, [&](int) { total.fetch_add(1); }, 1);
+        }, 1);
+        EXPECT_EQ(total.load(), 16000u);
+    }
+}
+
+// A shut-down pool refuses helpers; the caller does the whole range
+TEST(ParallelAlgorithmsTest, RunsInlineOnShutDownPool) {
+    ThreadPool pool(2);
+    pool.shutdown();
+    std::vector<int> values(50000, 1);
+    EXPECT_EQ(parallel_transform_reduce(pool, values.begin(), values.end(), 0, std::plus<>(),
+                                        [](int v) { return v; }),
+              50000);
+}
+
+// The first body exception reaches the caller; later chunks are abandoned
+TEST(ParallelAlgorithmsTest, ExceptionPropagates) {
+    ThreadPool pool(4);
+    std::atomic<size_t> visited{0};
+    EXPECT_THROW(parallel_for(pool, size_t{0}, size_t{1000000}, [&](size_t i) {
+                     visited.fetch_add(1);
+                     if (i == 10) {
+                         throw std::runtime_error("boom");
+                     }
+                 }, 100),
+                 std::runtime_error);
+    EXPECT_LT(visited.load(), 1000000u);
+
+    // The pool is still usable afterwards
+    std::atomic<int> after{0};
+    parallel_for(pool, 0, 100, [&](int) { after.fetch_add(1); });
+    EXPECT_EQ(after.load(), 100);
+}
@@ -0,0 +1,101 @@
+// QueueGroup routing tests against a real server. They need a local
+// nats-server at NATS_URL or nats://localhost:4222 and are skipped when
+// none is reachable.
+#include <gtest/gtest.h>
+#include "libs/common/service_host.hpp"
+#include "messages.pb.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+std::string nats_url() {
+    const char* url = std::getenv("NATS_URL");
+    return url ? url : "nats://localhost:4222";
+}
+
+ServiceInitConfig minimal_config() {
+    ServiceInitConfig config;
+    config.nats_url = nats_url();
+    config.enable_jetstream = false;
+    config.enable_cache = false;
+    config.enable_scheduler = false;
+    config.enable_permanent_tasks = false;
+    config.enable_metrics_server = false;
+    return config;
+}
+
+} // namespace
+
+class QueueGroupTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (natsConnection_ConnectTo(&publisher_, nats_url().c_str()) != NATS_OK) {
+            publisher_ = nullptr;
+            GTEST_SKIP() << "No NATS server reachable";
+        }
+    }
+
+    void TearDown() override {
+        if (publisher_) {
+            natsConnection_Destroy(publisher_);
+        }
+    }
+
+    void publish(const google::protobuf::Message& message, int count) {
+        const std::string subject = "system.broadcast." + message.GetDescriptor()->full_name();
+        const std::string payload = message.SerializeAsString();
+        for (int i = 0; i < count; ++i) {
+            ASSERT_EQ(natsConnection_Publish(publisher_, subject.c_str(), payload.data(),
+                                             static_cast<int>(payload.size())),
+                      NATS_OK);
+        }
+        ASSERT_EQ(natsConnection_Flush(publisher_), NATS_OK);
+    }
+
+    natsConnection* publisher_ = nullptr;
+};
+
+// Replicas of one service split the messages; each is handled exactly once
+TEST_F(QueueGroupTest, ReplicasShareMessages) {
+    const int count = 2000;
+    const std::string type_name = Trevor::HealthCheckRequest::descriptor()->full_name();
+    std::atomic<int> handled[2] = {{0}, {0}};
+    std::unique_ptr<ServiceHost> replicas[2];
+    for (int r = 0; r < 2; ++r) {
+        replicas[r] = std::make_unique<ServiceHost>("queue-replica-" + std::to_string(r), "QueueGroupTest");
+        replicas[r]->StartService(minimal_config());
+        replicas[r]->register_message<Trevor::HealthCheckRequest>(
+            MessageRouting::QueueGroup,
+            [&handled, r](const Trevor::HealthCheckRequest&) { handled[r].fetch_add(1); });
+    }
+    // A different service on the same subject still gets every message
+    std::atomic<int> observed{0};
+    ServiceHost observer("queue-observer", "QueueGroupObserver");
+    observer.StartService(minimal_config());
+    observer.register_message<Trevor::HealthCheckRequest>(
+        MessageRouting::QueueGroup,
+        [&observed](const Trevor::HealthCheckRequest&) { observed.fetch_add(1); });
+
+    Trevor::HealthCheckRequest request;
+    request.set_service_name("queue-test");
+    publish(request, count);
+
+    auto start = std::chrono::steady_clock::now();
+    while ((handled[0] + handled[1] < count || observed < count) &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Catch duplicates
+
+    EXPECT_EQ(handled[0] + handled[1], count);
+    EXPECT_EQ(observed.load(), count);
+    for (int r = 0; r < 2; ++r) {
+        EXPECT_EQ(replicas[r]->delivered_messages(type_name), static_cast<size_t>(handled[r].load()));
+        EXPECT_GT(handled[r].load(), count / 10) << "replica " << r << " starved";
+    }
+}
@@ -0,0 +1,187 @@
+// ServiceHost::request / register_request_handler tests against a real
+// server. They need a local nats-server at NATS_URL or nats://localhost:4222
+// and are skipped when none is reachable.
+#include <gtest/gtest.h>
+#include "libs/common/service_host.hpp"
+#include "messages.pb.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string nats_url() {
+    const char* url = std::getenv("NATS_URL");
+    return url ? url : "nats://localhost:4222";
+}
+
+ServiceInitConfig minimal_config() {
+    ServiceInitConfig config;
+    config.nats_url = nats_url();
+    config.enable_jetstream = false;
+    config.enable_cache = false;
+    config.enable_scheduler = false;
+    config.enable_permanent_tasks = false;
+    config.enable_metrics_server = false;
+    return config;
+}
+
+using Request = Trevor::HealthCheckRequest;
+using Response = Trevor::HealthCheckResponse;
+
+} // namespace
+
+class RequestReplyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        natsConnection* probe = nullptr;
+        if (natsConnection_ConnectTo(&probe, nats_url().c_str()) != NATS_OK) {
+            GTEST_SKIP() << "No NATS server reachable";
+        }
+        natsConnection_Destroy(probe);
+
+        responder_ = std::make_unique<ServiceHost>("reply-responder", "RequestReplyResponder");
+        responder_->StartService(minimal_config());
+        requester_ = std::make_unique<ServiceHost>("reply-requester", "RequestReplyRequester");
+        requester_->StartService(minimal_config());
+    }
+
+    // Echo the request's service_name so replies can be matched to requests
+    void register_echo() {
+        responder_->register_request_handler<Request, Response>(
+            MessageRouting::PointToPoint,
+            [this](const Request& req) {
+                handled_.fetch_add(1);
+                if (req.service_name() == "throw") {
+                    throw std::runtime_error("no answer");
+                }
+                Response res;
+                res.set_service_name(req.service_name());
+                res.set_uid(responder_->get_uid());
+                return res;
+            });
+    }
+
+    static Request make_request(const std::string& name) {
+        Request req;
+        req.set_service_name(name);
+        req.set_uid("reply-requester");
+        return req;
+    }
+
+    std::unique_ptr<ServiceHost> responder_;
+    std::unique_ptr<ServiceHost> requester_;
+    std::atomic<int> handled_{0};
+};
+
+TEST_F(RequestReplyTest, ReturnsTypedResponse) {
+    register_echo();
+    auto reply = requester_->request<Request, Response>(responder_->get_uid(), make_request("ping"),
+                                                         std::chrono::seconds(2));
+    ASSERT_TRUE(reply.wait_for(std::chrono::seconds(3)));
+    EXPECT_EQ(reply.get().service_name(), "ping");
+    EXPECT_EQ(reply.get().uid(), responder_->get_uid());
+}
+
+// Replies are matched to their own request, however many are in flight
+TEST_F(RequestReplyTest, ConcurrentRequestsGetTheirOwnReplies) {
+    register_echo();
+    const int count = 500;
+    std::vector<TaskFuture<Response>> replies;
+    replies.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        replies.push_back(requester_->request<Request, Response>(
+            responder_->get_uid(), make_request("req-" + std::to_string(i)), std::chrono::seconds(5)));
+    }
+    for (int i = 0; i < count; ++i) {
+        ASSERT_TRUE(replies[i].wait_for(std::chrono::seconds(6))) << "request " << i;
+        EXPECT_EQ(replies[i].get().service_name(), "req-" + std::to_string(i));
+    }
+    EXPECT_EQ(handled_.load(), count);
+}
+
+// A handler that throws sends nothing; the request fails at its timeout
+TEST_F(RequestReplyTest, TimesOutWithoutReply) {
+    register_echo();
+    const auto start = std::chrono::steady_clock::now();
+    auto reply = requester_->request<Request, Response>(responder_->get_uid(), make_request("throw"),
+                                                         std::chrono::milliseconds(200));
+    ASSERT_TRUE(reply.wait_for(std::chrono::seconds(3)));
+    EXPECT_THROW(reply.get(), std::runtime_error);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(200));
+
+    // The inbox still works after a timeout
+    auto next = requester_->request<Request, Response>(responder_->get_uid(), make_request("after"),
+                                                        std::chrono::seconds(2));
+    ASSERT_TRUE(next.wait_for(std::chrono::seconds(3)));
+    EXPECT_EQ(next.get().service_name(), "after");
+}
+
+// Nobody subscribed: the server's no-responders status fails the request early
+TEST_F(RequestReplyTest, FailsWithoutResponder) {
+    auto reply = requester_->request<Request, Response>("no-such-service", make_request("ping"),
+                                                         std::chrono::seconds(10));
+    ASSERT_TRUE(reply.wait_for(std::chrono::seconds(5)));
+    EXPECT_THROW(reply.get(), std::runtime_error);
+}
+
+// A request published without a reply subject goes to the no_reply fallback
+TEST_F(RequestReplyTest, PlainPublishUsesFallback) {
+    std::atomic<int> fallback{0};
+    responder_->register_request_handler<Request, Response>(
+        MessageRouting::PointToPoint,
+        [](const Request& req) {
+            Response res;
+            res.set_service_name(req.service_name());
+            return res;
+        },
+        TaskPriority::Normal,
+        [&fallback](const Request& req, const Response& res) {
+            EXPECT_EQ(req.service_name(), res.service_name());
+            fallback.fetch_add(1);
+        });
+
+    natsConnection* conn = nullptr;
+    ASSERT_EQ(natsConnection_ConnectTo(&conn, nats_url().c_str()), NATS_OK);
+    const std::string subject = "system.direct." + responder_->get_uid() + "." + Request::descriptor()->full_name();
+    const std::string payload = make_request("plain").SerializeAsString();
+    ASSERT_EQ(natsConnection_Publish(conn, subject.c_str(), payload.data(), static_cast<int>(payload.size())),
+              NATS_OK);
+    natsConnection_Flush(conn);
+
+    auto start = std::chrono::steady_clock::now();
+    while (fallback.load() == 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(fallback.load(), 1);
+    natsConnection_Destroy(conn);
+}
+
+// request_async shares the inbox and hands back the raw payload
+TEST_F(RequestReplyTest, RequestAsyncReturnsPayload) {
+    register_echo();
+    const std::string subject = "system.direct." + responder_->get_uid() + "." + Request::descriptor()->full_name();
+    auto reply = requester_->request_async(subject, make_request("raw").SerializeAsString(), std::chrono::seconds(2));
+    ASSERT_TRUE(reply.wait_for(std::chrono::seconds(3)));
+    Response res;
+    ASSERT_TRUE(res.ParseFromString(reply.get()));
+    EXPECT_EQ(res.service_name(), "raw");
+}
+
+// Once the inbox is closed a request fails straight away, exactly once
+TEST_F(RequestReplyTest, FailsAfterShutdown) {
+    register_echo();
+    auto first = requester_->request<Request, Response>(responder_->get_uid(), make_request("ping"),
+                                                         std::chrono::seconds(2));
+    ASSERT_TRUE(first.wait_for(std::chrono::seconds(3)));
+    requester_->shutdown();
+
+    auto reply = requester_->request<Request, Response>(responder_->get_uid(), make_request("late"),
+                                                         std::chrono::seconds(2));
+    ASSERT_TRUE(reply.wait_for(std::chrono::seconds(1)));
+    EXPECT_THROW(reply.get(), std::runtime_error);
+}
@@ -3,9 +3,14 @@
 #include "service_host.hpp"
 #include "logger.hpp"
 #include "messages.pb.h"
+#include <algorithm>
 #include <chrono>
+#include <mutex>
+#include <numeric>
 #include <thread>
 #include <fstream>
+#include <future>
+#include <vector>
 
 TEST_CASE("ServiceHost handles HealthCheckRequest", "[ServiceHost]") {
     ServiceHost svc("test-uid", "TestService");
@@ -38,6 +43,134 @@ TEST_CASE("ServiceHost handles HealthCheckRequest", "[ServiceHost]") {
     REQUIRE(called);
 }
 
+TEST_CASE("ServiceHost parses messages on a pool worker", "[ServiceHost]") {
+    ServiceHost svc("test-uid", "TestService");
+
+    std::atomic<int> positions{-1};
+    std::atomic<bool> on_worker{false};
+    const auto caller = std::this_thread::get_id();
+    svc.register_message<Trevor::PortfolioResponse>(
+        MessageRouting::Broadcast,
+        [&](const Trevor::PortfolioResponse& response) {
+            on_worker = std::this_thread::get_id() != caller;
+            positions = response.positions_size();
+        }
+    );
+
+    Trevor::PortfolioResponse response;
+    response.set_account_id("ACC-1");
+    for (int i = 0; i < 25; ++i) {
+        response.add_positions()->set_symbol("SYM" + std::to_string(i));
+    }
+    svc.receive_message(Trevor::PortfolioResponse::descriptor()->full_name(),
+                        MessageBuffer::copy_of(response.SerializeAsString()));
+
+    auto start = std::chrono::steady_clock::now();
+    while (positions < 0 &&
+           std::chrono::steady_clock::now() - start < std::chrono::milliseconds(1000)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    REQUIRE(positions == 25);
+    REQUIRE(on_worker);
+}
+
+TEST_CASE("ServiceHost conflates updates per key", "[ServiceHost]") {
+    ServiceHost svc("test-uid", "TestService");
+
+    std::promise<void> started;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::mutex mtx;
+    std::vector<double> prices;
+    svc.register_conflated_message<Trevor::MarketDataUpdate>(
+        MessageRouting::Broadcast,
+        [&](const Trevor::MarketDataUpdate& update) {
+            if (update.price() == 1.0) {
+                started.set_value();
+                released.wait();
+            }
+            std::lock_guard<std::mutex> lk(mtx);
+            prices.push_back(update.price());
+        },
+        [](const Trevor::MarketDataUpdate& update) { return update.symbol(); }
+    );
+
+    const std::string type_name = Trevor::MarketDataUpdate::descriptor()->full_name();
+    auto send = [&](double price) {
+        Trevor::MarketDataUpdate update;
+        update.set_symbol("AAPL");
+        update.set_price(price);
+        svc.receive_message(type_name, MessageBuffer::copy_of(update.SerializeAsString()));
+    };
+
+    // Updates 2..5 arrive while 1 is being handled; only 5 is worth handling
+    send(1.0);
+    started.get_future().wait();
+    for (int price = 2; price <= 5; ++price) {
+        send(price);
+    }
+    release.set_value();
+
+    auto start = std::chrono::steady_clock::now();
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            if (prices.size() == 2) break;
+        }
+        if (std::chrono::steady_clock::now() - start > std::chrono::milliseconds(2000)) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::lock_guard<std::mutex> lk(mtx);
+    REQUIRE(prices == std::vector<double>{1.0, 5.0});
+}
+
+TEST_CASE("ServiceHost delivers batch messages in batches", "[ServiceHost]") {
+    ServiceHost svc("test-uid", "TestService");
+    svc.get_scheduler().start();
+
+    std::mutex mtx;
+    std::vector<size_t> batch_sizes;
+    std::vector<double> quantities;
+    svc.register_batch_message<Trevor::Position>(
+        MessageRouting::Broadcast, 4, std::chrono::milliseconds(20),
+        [&](BatchView<Trevor::Position> batch) {
+            std::lock_guard<std::mutex> lk(mtx);
+            batch_sizes.push_back(batch.size());
+            for (const auto& position : batch) {
+                quantities.push_back(position.quantity());
+            }
+        }
+    );
+
+    const std::string type_name = Trevor::Position::descriptor()->full_name();
+    for (int i = 0; i < 10; ++i) {
+        Trevor::Position position;
+        position.set_quantity(i);
+        svc.receive_message(type_name, MessageBuffer::copy_of(position.SerializeAsString()));
+    }
+
+    // Two full batches right away, the last two once max_delay has passed
+    auto start = std::chrono::steady_clock::now();
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            if (quantities.size() == 10) break;
+        }
+        if (std::chrono::steady_clock::now() - start > std::chrono::milliseconds(2000)) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    svc.get_scheduler().stop();
+
+    std::lock_guard<std::mutex> lk(mtx);
+    REQUIRE(batch_sizes == std::vector<size_t>{4, 4, 2});
+    std::vector<double> expected(10);
+    std::iota(expected.begin(), expected.end(), 0.0);
+    std::sort(quantities.begin(), quantities.end());
+    REQUIRE(quantities == expected);
+}
+
 TEST_CASE("Logger creates correlation IDs and handles daily rotation", "[Logger]") {
     Logger logger("TestService");
     
@@ -60,6 +193,28 @@ TEST_CASE("Logger creates correlation IDs and handles daily rotation", "[Logger]
     logger.error("Error test");
 }
 
+TEST_CASE("RequestContext carries fresh trace IDs on the parent's sinks", "[Logger]") {
+    Logger logger("TestService");
+
+    auto context = logger.create_request_context();
+    REQUIRE(context.get_correlation_id().length() == 8);
+    REQUIRE(context.get_trace_id().length() == 16);
+    REQUIRE(context.get_span_id().length() == 8);
+    REQUIRE(context.get_trace_id() != logger.get_trace_id());
+
+    // IDs are fixed per context and differ between contexts
+    auto copy = context;
+    REQUIRE(copy.get_trace_id() == context.get_trace_id());
+    REQUIRE(logger.create_request_context().get_trace_id() != context.get_trace_id());
+
+    auto full = context.to_logger();
+    REQUIRE(full->get_correlation_id() == context.get_correlation_id());
+    REQUIRE(full->get_service_name() == "TestService");
+
+    context.info("Processing order: {}", 42);
+    context.debug("Below the default level");
+}
+
 TEST_CASE("Logger supports distributed tracing with trace_id and span_id", "[Logger]") {
     Logger logger("TestService");
     
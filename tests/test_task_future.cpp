@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "libs/common/task_future.hpp"
+#include "libs/common/thread_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TaskFutureTest : public ::testing::TestWithParam<ThreadPool::SchedulingMode> {
+};
+
+// Values and exceptions come back through get()
+TEST_P(TaskFutureTest, SubmitWithResult) {
+    ThreadPool pool(2, GetParam());
+
+    auto answer = pool.submit_with_result([]() { return 42; });
+    auto text = pool.submit_with_result([]() { return std::string("done"); });
+    auto failed = pool.submit_with_result([]() -> int { throw std::runtime_error("boom"); });
+    std::atomic<bool> ran{false};
+    auto nothing = pool.submit_with_result([&ran]() { ran = true; });
+
+    EXPECT_EQ(answer.get(), 42);
+    EXPECT_EQ(text.get(), "done");
+    EXPECT_THROW(failed.get(), std::runtime_error);
+    nothing.get();
+    EXPECT_TRUE(ran.load());
+    EXPECT_TRUE(answer.is_ready());
+
+    pool.shutdown();
+    auto refused = pool.submit_with_result([]() { return 1; });
+    EXPECT_TRUE(refused.is_ready());
+    EXPECT_THROW(refused.get(), std::runtime_error);
+}
+
+// Continuations run on pool workers and chain values; failures skip them
+TEST_P(TaskFutureTest, ThenRunsOnPool) {
+    ThreadPool pool(2, GetParam());
+
+    auto chained = pool.submit_with_result([]() { return 20; })
+                       .then([](const int& v) { return v + 1; })
+                       .then([](const int& v) { return v * 2; });
+    EXPECT_EQ(chained.get(), 42);
+
+    std::thread::id caller = std::this_thread::get_id();
+    std::atomic<bool> on_other_thread{false};
+    pool.submit_with_result([]() {})
+        .then([&]() { on_other_thread = std::this_thread::get_id() != caller; })
+        .get();
+    EXPECT_TRUE(on_other_thread.load());
+
+    std::atomic<bool> skipped{true};
+    auto failed = pool.submit_with_result([]() -> int { throw std::runtime_error("boom"); })
+                      .then([&skipped](const int&) {
+                          skipped = false;
+                          return 0;
+                      });
+    EXPECT_THROW(failed.get(), std::runtime_error);
+    EXPECT_TRUE(skipped.load());
+
+    // Continuation attached after completion still runs
+    auto ready = pool.submit_with_result([]() { return 1; });
+    ready.wait();
+    EXPECT_EQ(ready.then([](const int& v) { return v + 1; }).get(), 2);
+}
+
+TEST_P(TaskFutureTest, WhenAllAndWhenAny) {
+    ThreadPool pool(4, GetParam());
+
+    std::vector<TaskFuture<int>> futures;
+    for (int i = 0; i < 16; ++i) {
+        futures.push_back(pool.submit_with_result([i]() { return i * i; }));
+    }
+    auto all = when_all(futures).get();
+    ASSERT_EQ(all.size(), 16u);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_EQ(all[i], i * i);
+    }
+
+    std::vector<TaskFuture<void>> voids;
+    std::atomic<int> count{0};
+    for (int i = 0; i < 8; ++i) {
+        voids.push_back(pool.submit_with_result([&count]() { count.fetch_add(1); }));
+    }
+    when_all(voids).get();
+    EXPECT_EQ(count.load(), 8);
+    when_all(std::vector<TaskFuture<void>>{}).get();
+
+    futures.push_back(pool.submit_with_result([]() -> int { throw std::logic_error("bad"); }));
+    EXPECT_THROW(when_all(futures).get(), std::logic_error);
+
+    // The fast task wins over one blocked on a promise
+    TaskPromise<int> gate;
+    std::vector<TaskFuture<int>> race{gate.get_future(),
+                                      pool.submit_with_result([]() { return 7; })};
+    size_t first = when_any(race).get();
+    EXPECT_EQ(first, 1u);
+    EXPECT_EQ(race[first].get(), 7);
+    gate.set_value(0);
+    EXPECT_THROW(when_any(std::vector<TaskFuture<int>>{}).get(), std::invalid_argument);
+}
+
+// A promise dropped without a result fails its future instead of hanging
+TEST(TaskPromiseTest, BrokenPromise) {
+    TaskFuture<int> future;
+    {
+        TaskPromise<int> promise;
+        future = promise.get_future();
+    }
+    EXPECT_TRUE(future.is_ready());
+    EXPECT_THROW(future.get(), std::runtime_error);
+
+    TaskPromise<int> promise;
+    auto kept = promise.get_future();
+    promise.set_value(1);
+    promise.set_value(2);  // Ignored
+    EXPECT_EQ(kept.get(), 1);
+    EXPECT_TRUE(kept.wait_for(std::chrono::milliseconds(0)));
+}
+
+INSTANTIATE_TEST_SUITE_P(SchedulingModes, TaskFutureTest,
+                         ::testing::Values(ThreadPool::SchedulingMode::SharedQueue,
+                                           ThreadPool::SchedulingMode::WorkStealing,
+                                           ThreadPool::SchedulingMode::LockFreeRing));
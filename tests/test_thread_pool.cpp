@@ -4,6 +4,13 @@
 #include <chrono>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <array>
+#include <future>
+#include <functional>
+#include <string>
+#include <sched.h>
 
 class ThreadPoolTest : public ::testing::Test {
 protected:
@@ -240,7 +247,7 @@ TEST_F(ThreadPoolTest, StressTest) {
             // Simulate some work
             volatile int x = 0;
             for (int j = 0; j < 100; ++j) {
-                x += j;
+                x = x + j;
             }
         });
         EXPECT_TRUE(submitted);
@@ -280,3 +287,763 @@ TEST_F(ThreadPoolTest, RAIIBehavior) {
     // All tasks should have completed
     EXPECT_EQ(counter.load(), 10);
 }
+
+// Test work-stealing mode processes external submissions
+TEST_F(ThreadPoolTest, WorkStealingBasicFunctionality) {
+    ThreadPool pool(4, ThreadPool::SchedulingMode::WorkStealing);
+    std::atomic<int> counter{0};
+
+    EXPECT_EQ(pool.scheduling_mode(), ThreadPool::SchedulingMode::WorkStealing);
+
+    for (int i = 0; i < 1000; ++i) {
+        bool submitted = pool.submit([&counter]() {
+            counter.fetch_add(1);
+        });
+        EXPECT_TRUE(submitted);
+    }
+
+    while (counter.load() < 1000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(counter.load(), 1000);
+    EXPECT_EQ(pool.pending_tasks(), 0);
+}
+
+// Test nested submissions from workers land on the local deque and get stolen
+TEST_F(ThreadPoolTest, WorkStealingNestedSubmissions) {
+    ThreadPool pool(4, ThreadPool::SchedulingMode::WorkStealing);
+    std::atomic<int> counter{0};
+    std::mutex ids_mutex;
+    std::set<std::thread::id> child_threads;
+
+    // One parent fans out many children onto its own deque
+    pool.submit([&]() {
+        for (int i = 0; i < 200; ++i) {
+            pool.submit([&]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                {
+                    std::lock_guard<std::mutex> lock(ids_mutex);
+                    child_threads.insert(std::this_thread::get_id());
+                }
+                counter.fetch_add(1);
+            });
+        }
+    });
+
+    while (counter.load() < 200) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(counter.load(), 200);
+    // Idle workers stole from the parent's deque (only meaningful with real parallelism)
+    if (std::thread::hardware_concurrency() > 1) {
+        EXPECT_GT(child_threads.size(), 1u);
+    }
+}
+
+// Test pending_tasks() and shutdown() contract in work-stealing mode
+TEST_F(ThreadPoolTest, WorkStealingPendingAndShutdown) {
+    std::atomic<int> counter{0};
+
+    {
+        ThreadPool pool(1, ThreadPool::SchedulingMode::WorkStealing);
+
+        for (int i = 0; i < 20; ++i) {
+            pool.submit([&counter]() {
+                counter.fetch_add(1);
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            });
+        }
+
+        EXPECT_GT(pool.pending_tasks(), 0);
+
+        // Shutdown drains everything already accepted
+        pool.shutdown();
+        EXPECT_TRUE(pool.is_shutdown());
+        EXPECT_EQ(counter.load(), 20);
+        EXPECT_EQ(pool.pending_tasks(), 0);
+
+        // Submissions after shutdown are rejected
+        EXPECT_FALSE(pool.submit([&counter]() { counter.fetch_add(1); }));
+    }
+
+    EXPECT_EQ(counter.load(), 20);
+}
+
+// Test the lock-free ring backend: nested submissions, pending count, drain on shutdown
+TEST_F(ThreadPoolTest, LockFreeRingSubmitAndShutdown) {
+    std::atomic<int> counter{0};
+    {
+        ThreadPool pool(4, ThreadPool::SchedulingMode::LockFreeRing);
+        EXPECT_EQ(pool.scheduling_mode(), ThreadPool::SchedulingMode::LockFreeRing);
+
+        for (int i = 0; i < 50; ++i) {
+            EXPECT_TRUE(pool.submit([&]() {
+                for (int j = 0; j < 20; ++j) {
+                    pool.submit([&counter]() { counter.fetch_add(1); });
+                }
+                counter.fetch_add(1);
+            }));
+        }
+        while (counter.load() < 50 * 21) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(pool.pending_tasks(), 0u);
+
+        // Shutdown drains everything already accepted
+        for (int i = 0; i < 20; ++i) {
+            pool.submit([&counter]() { counter.fetch_add(1); });
+        }
+        pool.shutdown();
+        EXPECT_FALSE(pool.submit([&counter]() { counter.fetch_add(1); }));
+    }
+    EXPECT_EQ(counter.load(), 50 * 21 + 20);
+}
+
+// Test a full ring: a worker runs its overflow inline instead of waiting on
+// itself, external submitters wait for room
+TEST_F(ThreadPoolTest, LockFreeRingFullRing) {
+    ThreadPool::Options options;
+    options.threads = 1;
+    options.mode = ThreadPool::SchedulingMode::LockFreeRing;
+    options.ring_capacity = 4;
+    ThreadPool pool(options);
+
+    std::atomic<int> counter{0};
+    std::atomic<int> inline_runs{-1};
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+
+    pool.submit([&, opened]() {
+        // Fill the ring from the worker itself: the overflow runs right here
+        for (int i = 0; i < 10; ++i) {
+            pool.submit([&counter]() { counter.fetch_add(1); });
+        }
+        inline_runs = counter.load();
+        opened.wait();
+    });
+    while (inline_runs.load() < 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(inline_runs.load(), 6);
+
+    std::atomic<bool> returned{false};
+    std::thread producer([&]() {
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_TRUE(pool.submit([&counter]() { counter.fetch_add(1); }));
+        }
+        returned = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(returned.load());  // The ring still holds 4 of the worker's tasks
+
+    gate.set_value();
+    producer.join();
+    pool.shutdown();
+    EXPECT_EQ(counter.load(), 20);
+}
+
+// Test typical handler captures stay in InlineTask's inline buffer
+TEST_F(ThreadPoolTest, InlineTaskTypicalCaptureDoesNotSpill) {
+    ThreadPool pool(2);
+    std::atomic<int> counter{0};
+
+    // Mirrors register_message(): handler, parsed message, logger, type name, timestamp
+    std::function<void(int)> handler = [&counter](int v) { counter.fetch_add(v); };
+    struct { char fields[88]; } message{};
+    auto logger = std::make_shared<int>(1);
+    std::string type_name = "Trevor.PortfolioResponse";
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    auto closure = [handler, message, logger, type_name, start_time]() {
+        (void)message; (void)type_name; (void)start_time;
+        handler(*logger);
+    };
+    EXPECT_TRUE(InlineTask(closure).is_inline());
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(pool.submit(closure));
+    }
+    pool.shutdown();
+
+    EXPECT_EQ(counter.load(), 10);
+    EXPECT_EQ(pool.heap_spilled_tasks(), 0);
+}
+
+// Test oversized captures spill to the heap and are counted
+TEST_F(ThreadPoolTest, InlineTaskOversizedCaptureSpills) {
+    ThreadPool pool(2);
+    std::atomic<int> counter{0};
+
+    std::array<char, InlineTask::kInlineCapacity + 1> big{};
+    big[0] = 1;
+    for (int i = 0; i < 5; ++i) {
+        pool.submit([&counter, big]() { counter.fetch_add(big[0]); });
+    }
+    pool.shutdown();
+
+    EXPECT_EQ(counter.load(), 5);
+    EXPECT_EQ(pool.heap_spilled_tasks(), 5);
+}
+
+// Test move-only captures are accepted (std::function would reject them)
+TEST_F(ThreadPoolTest, InlineTaskMoveOnlyCapture) {
+    ThreadPool pool(1);
+    std::promise<int> promise;
+    auto future = promise.get_future();
+    auto value = std::make_unique<int>(42);
+
+    EXPECT_TRUE(pool.submit([promise = std::move(promise), value = std::move(value)]() mutable {
+        promise.set_value(*value);
+    }));
+
+    EXPECT_EQ(future.get(), 42);
+}
+
+// Test batch submission in both scheduling modes
+TEST_F(ThreadPoolTest, SubmitBatch) {
+    for (auto mode : {ThreadPool::SchedulingMode::SharedQueue, ThreadPool::SchedulingMode::WorkStealing,
+                      ThreadPool::SchedulingMode::LockFreeRing}) {
+        ThreadPool pool(4, mode);
+        std::atomic<int> counter{0};
+
+        std::vector<std::function<void()>> batch;
+        for (int i = 0; i < 100; ++i) {
+            batch.push_back([&counter]() { counter.fetch_add(1); });
+        }
+        EXPECT_TRUE(pool.submit_batch(batch));
+
+        // Empty batch is accepted and does nothing
+        std::vector<std::function<void()>> empty;
+        EXPECT_TRUE(pool.submit_batch(empty));
+
+        pool.shutdown();
+        EXPECT_EQ(counter.load(), 100);
+
+        // Batches after shutdown are rejected as a whole
+        std::vector<std::function<void()>> late;
+        late.push_back([&counter]() { counter.fetch_add(1); });
+        EXPECT_FALSE(pool.submit_batch(late));
+        EXPECT_EQ(counter.load(), 100);
+    }
+}
+
+// Test a batch submitted from inside a worker in work-stealing mode
+TEST_F(ThreadPoolTest, SubmitBatchFromWorker) {
+    ThreadPool pool(4, ThreadPool::SchedulingMode::WorkStealing);
+    std::atomic<int> counter{0};
+
+    pool.submit([&]() {
+        std::vector<InlineTask> children;
+        for (int i = 0; i < 50; ++i) {
+            children.emplace_back([&counter]() { counter.fetch_add(1); });
+        }
+        pool.submit_batch(children);
+    });
+
+    while (counter.load() < 50) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(counter.load(), 50);
+}
+
+// Helper: single-worker pool whose worker is parked on a gate, so the
+// dequeue order of everything submitted afterwards is deterministic
+namespace {
+std::vector<char> run_lanes_in_order(ThreadPool::Options options,
+                                     int high_tasks, int normal_tasks) {
+    options.threads = 1;
+    ThreadPool pool(options);
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    std::mutex order_mutex;
+    std::vector<char> order;
+
+    pool.submit([opened]() { opened.wait(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // Normal work is queued first so only the lane policy can reorder it
+    for (int i = 0; i < normal_tasks; ++i) {
+        pool.submit([&]() { std::lock_guard<std::mutex> lk(order_mutex); order.push_back('N'); });
+    }
+    for (int i = 0; i < high_tasks; ++i) {
+        pool.submit([&]() { std::lock_guard<std::mutex> lk(order_mutex); order.push_back('H'); },
+                    TaskPriority::High);
+    }
+    EXPECT_EQ(pool.pending_tasks(TaskPriority::High), static_cast<size_t>(high_tasks));
+    EXPECT_EQ(pool.pending_tasks(TaskPriority::Normal), static_cast<size_t>(normal_tasks));
+
+    gate.set_value();
+    pool.shutdown();
+    return order;
+}
+} // namespace
+
+// Test strict lanes: every High task runs before any queued Normal task
+TEST_F(ThreadPoolTest, StrictPriorityLanes) {
+    for (auto mode : {ThreadPool::SchedulingMode::SharedQueue, ThreadPool::SchedulingMode::WorkStealing,
+                      ThreadPool::SchedulingMode::LockFreeRing}) {
+        ThreadPool::Options options;
+        options.mode = mode;
+        options.lane_policy = ThreadPool::LanePolicy::Strict;
+
+        auto order = run_lanes_in_order(options, 3, 3);
+        EXPECT_EQ(std::string(order.begin(), order.end()), "HHHNNN");
+    }
+}
+
+// Test weighted lanes: Normal work still progresses under a High flood
+TEST_F(ThreadPoolTest, WeightedPriorityLanes) {
+    for (auto mode : {ThreadPool::SchedulingMode::SharedQueue, ThreadPool::SchedulingMode::WorkStealing,
+                      ThreadPool::SchedulingMode::LockFreeRing}) {
+        ThreadPool::Options options;
+        options.mode = mode;
+        options.lane_policy = ThreadPool::LanePolicy::Weighted;
+        options.high_priority_weight = 2;
+
+        auto order = run_lanes_in_order(options, 6, 3);
+        EXPECT_EQ(std::string(order.begin(), order.end()), "HHNHHNHHN");
+    }
+}
+
+// Test that High-lane batches are accepted and drained on shutdown
+TEST_F(ThreadPoolTest, PriorityBatchDrainsOnShutdown) {
+    for (auto mode : {ThreadPool::SchedulingMode::SharedQueue, ThreadPool::SchedulingMode::WorkStealing,
+                      ThreadPool::SchedulingMode::LockFreeRing}) {
+        ThreadPool pool(4, mode);
+        std::atomic<int> counter{0};
+
+        std::vector<std::function<void()>> batch;
+        for (int i = 0; i < 64; ++i) {
+            batch.push_back([&counter]() { counter.fetch_add(1); });
+        }
+        EXPECT_TRUE(pool.submit_batch(batch, TaskPriority::High));
+        EXPECT_TRUE(pool.submit([&counter]() { counter.fetch_add(1); }));
+
+        pool.shutdown();
+        EXPECT_EQ(counter.load(), 65);
+        EXPECT_FALSE(pool.submit([&counter]() { counter.fetch_add(1); }, TaskPriority::High));
+    }
+}
+
+// Test CPU list parsing used by the threads.cpu_list config key
+TEST_F(ThreadPoolTest, ParseCpuList) {
+    EXPECT_EQ(CpuTopology::parse_cpu_list("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(CpuTopology::parse_cpu_list(" 2, 1,2 "), (std::vector<int>{1, 2}));
+    EXPECT_TRUE(CpuTopology::parse_cpu_list("").empty());
+    EXPECT_TRUE(CpuTopology::parse_cpu_list("x,3-1,-2,4x").empty());
+}
+
+// Test that workers pinned via cpu_list run on, and report, that CPU
+TEST_F(ThreadPoolTest, PinnedWorkersReportCpu) {
+    cpu_set_t allowed;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    int cpu = 0;
+    while (cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &allowed)) {
+        ++cpu;
+    }
+    ASSERT_LT(cpu, CPU_SETSIZE);
+
+    for (auto mode : {ThreadPool::SchedulingMode::SharedQueue, ThreadPool::SchedulingMode::WorkStealing,
+                      ThreadPool::SchedulingMode::LockFreeRing}) {
+        ThreadPool::Options options;
+        options.threads = 2;
+        options.mode = mode;
+        options.cpu_list = {cpu};
+        ThreadPool pool(options);
+
+        std::promise<int> ran_on;
+        pool.submit([&ran_on]() { ran_on.set_value(sched_getcpu()); });
+        EXPECT_EQ(ran_on.get_future().get(), cpu);
+
+        // Workers record their CPU as they start; give the second one time
+        auto placement = pool.worker_placement();
+        for (int i = 0; i < 1000 && (placement[0].last_cpu < 0 || placement[1].last_cpu < 0); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            placement = pool.worker_placement();
+        }
+        ASSERT_EQ(placement.size(), 2u);
+        for (const auto& worker : placement) {
+            EXPECT_EQ(worker.cpus, std::vector<int>{cpu});
+            EXPECT_EQ(worker.node, -1);
+            EXPECT_EQ(worker.last_cpu, cpu);
+        }
+    }
+}
+
+// Test the per-NUMA-node layout: every worker belongs to a node sub-pool
+TEST_F(ThreadPoolTest, NumaAwarePlacement) {
+    auto nodes = CpuTopology::numa_nodes();
+    ASSERT_FALSE(nodes.empty());
+
+    ThreadPool::Options options;
+    options.threads = 4;
+    options.mode = ThreadPool::SchedulingMode::WorkStealing;
+    options.numa_aware = true;
+    ThreadPool pool(options);
+
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&counter]() { counter.fetch_add(1); });
+    }
+    pool.shutdown();
+    EXPECT_EQ(counter.load(), 100);
+
+    for (const auto& worker : pool.worker_placement()) {
+        ASSERT_GE(worker.node, 0);
+        ASSERT_LT(static_cast<size_t>(worker.node), nodes.size());
+        EXPECT_EQ(worker.cpus, nodes[worker.node]);
+    }
+}
+
+// Helper: single-worker bounded pool whose worker is parked on a gate
+namespace {
+struct GatedPool {
+    explicit GatedPool(ThreadPool::Options options) {
+        options.threads = 1;
+        pool = std::make_unique<ThreadPool>(options);
+        opened = gate.get_future().share();
+        pool->submit([f = opened]() { f.wait(); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    std::string finish() {
+        gate.set_value();
+        pool->shutdown();
+        return order;
+    }
+
+    std::function<void()> record(char c) {
+        return [this, c]() { std::lock_guard<std::mutex> lk(mtx); order.push_back(c); };
+    }
+
+    std::unique_ptr<ThreadPool> pool;
+    std::promise<void> gate;
+    std::shared_future<void> opened;
+    std::mutex mtx;
+    std::string order;
+};
+
+const ThreadPool::SchedulingMode kBothModes[] = {ThreadPool::SchedulingMode::SharedQueue,
+                                                 ThreadPool::SchedulingMode::WorkStealing};
+const ThreadPool::SchedulingMode kAllModes[] = {ThreadPool::SchedulingMode::SharedQueue,
+                                                ThreadPool::SchedulingMode::WorkStealing,
+                                                ThreadPool::SchedulingMode::LockFreeRing};
+} // namespace
+
+// Test Reject: submissions beyond capacity fail, the High lane is unbounded
+TEST_F(ThreadPoolTest, BoundedQueueReject) {
+    for (auto mode : kAllModes) {
+        ThreadPool::Options options;
+        options.mode = mode;
+        options.capacity = 2;
+        options.overflow = ThreadPool::OverflowPolicy::Reject;
+        GatedPool gated(options);
+
+        EXPECT_TRUE(gated.pool->submit(gated.record('a')));
+        EXPECT_TRUE(gated.pool->submit(gated.record('b')));
+        EXPECT_FALSE(gated.pool->submit(gated.record('c')));
+        EXPECT_TRUE(gated.pool->submit(gated.record('H'), TaskPriority::High));
+        EXPECT_EQ(gated.pool->rejected_tasks(), 1u);
+
+        EXPECT_EQ(gated.finish(), "Hab");
+    }
+}
+
+// Test DropOldest: the oldest droppable task makes room; others are kept
+TEST_F(ThreadPoolTest, BoundedQueueDropOldest) {
+    for (auto mode : kBothModes) {
+        ThreadPool::Options options;
+        options.mode = mode;
+        options.capacity = 2;
+        options.overflow = ThreadPool::OverflowPolicy::DropOldest;
+        GatedPool gated(options);
+
+        EXPECT_TRUE(gated.pool->submit(gated.record('x')));  // Never evicted
+        EXPECT_TRUE(gated.pool->submit_droppable(gated.record('a')));
+        EXPECT_TRUE(gated.pool->submit_droppable(gated.record('b')));  // Evicts 'a'
+        EXPECT_TRUE(gated.pool->submit(gated.record('c')));            // Evicts 'b'
+        EXPECT_FALSE(gated.pool->submit(gated.record('d')));           // Nothing droppable left
+        EXPECT_EQ(gated.pool->dropped_tasks(), 2u);
+        EXPECT_EQ(gated.pool->rejected_tasks(), 1u);
+
+        EXPECT_EQ(gated.finish(), "xc");
+    }
+}
+
+// Test DropNewestByKey: the newest queued task for the same key is replaced
+TEST_F(ThreadPoolTest, BoundedQueueDropNewestByKey) {
+    for (auto mode : kBothModes) {
+        ThreadPool::Options options;
+        options.mode = mode;
+        options.capacity = 3;
+        options.overflow = ThreadPool::OverflowPolicy::DropNewestByKey;
+        GatedPool gated(options);
+
+        EXPECT_TRUE(gated.pool->submit_droppable(gated.record('a'), 1));
+        EXPECT_TRUE(gated.pool->submit_droppable(gated.record('b'), 2));
+        EXPECT_TRUE(gated.pool->submit_droppable(gated.record('A'), 1));
+        EXPECT_TRUE(gated.pool->submit_droppable(gated.record('Z'), 1));  // Replaces 'A'
+        EXPECT_FALSE(gated.pool->submit_droppable(gated.record('c'), 3)); // No queued key 3
+        EXPECT_EQ(gated.pool->dropped_tasks(), 1u);
+        EXPECT_EQ(gated.pool->rejected_tasks(), 1u);
+
+        EXPECT_EQ(gated.finish(), "abZ");
+    }
+}
+
+// Test that the ring cannot evict: both drop policies reject when full
+TEST_F(ThreadPoolTest, LockFreeRingDropPoliciesReject) {
+    for (auto overflow : {ThreadPool::OverflowPolicy::DropOldest, ThreadPool::OverflowPolicy::DropNewestByKey}) {
+        ThreadPool::Options options;
+        options.mode = ThreadPool::SchedulingMode::LockFreeRing;
+        options.capacity = 1;
+        options.overflow = overflow;
+        GatedPool gated(options);
+
+        EXPECT_TRUE(gated.pool->submit_droppable(gated.record('a'), 1));
+        EXPECT_FALSE(gated.pool->submit_droppable(gated.record('b'), 1));
+        EXPECT_EQ(gated.pool->dropped_tasks(), 0u);
+        EXPECT_EQ(gated.pool->rejected_tasks(), 1u);
+
+        EXPECT_EQ(gated.finish(), "a");
+    }
+}
+
+// Test EDF: dated tasks run earliest deadline first, ahead of undated ones
+TEST_F(ThreadPoolTest, DeadlineEarliestFirst) {
+    GatedPool gated(ThreadPool::Options{});
+    auto now = std::chrono::steady_clock::now();
+
+    EXPECT_TRUE(gated.pool->submit_with_deadline(gated.record('c'), now + std::chrono::seconds(30)));
+    EXPECT_TRUE(gated.pool->submit_with_deadline(gated.record('a'), now + std::chrono::seconds(10)));
+    EXPECT_TRUE(gated.pool->submit(gated.record('x')));
+    EXPECT_TRUE(gated.pool->submit_droppable(gated.record('b'), 0, TaskPriority::Normal,
+                                             now + std::chrono::seconds(20)));
+    EXPECT_TRUE(gated.pool->submit(gated.record('y')));
+    EXPECT_TRUE(gated.pool->submit_with_deadline(gated.record('d'), now + std::chrono::seconds(30)));
+
+    EXPECT_EQ(gated.finish(), "abcdxy");
+    EXPECT_EQ(gated.pool->expired_tasks(), 0u);
+}
+
+// Test DropOldest under EDF: undated tasks are evicted first, then the
+// latest deadlines, never the most urgent ones
+TEST_F(ThreadPoolTest, DeadlineDropOldestEvictsLeastUrgent) {
+    ThreadPool::Options options;
+    options.capacity = 3;
+    options.overflow = ThreadPool::OverflowPolicy::DropOldest;
+    GatedPool gated(options);
+    auto now = std::chrono::steady_clock::now();
+    auto droppable = [&](char c, std::chrono::steady_clock::time_point deadline) {
+        return gated.pool->submit_droppable(gated.record(c), 0, TaskPriority::Normal, deadline);
+    };
+
+    EXPECT_TRUE(droppable('a', now + std::chrono::seconds(10)));
+    EXPECT_TRUE(droppable('c', now + std::chrono::seconds(30)));
+    EXPECT_TRUE(droppable('x', ThreadPool::kNoDeadline));
+    EXPECT_TRUE(droppable('b', now + std::chrono::seconds(20)));  // Evicts undated 'x'
+    EXPECT_TRUE(droppable('e', now + std::chrono::seconds(5)));   // Evicts latest 'c'
+    EXPECT_EQ(gated.pool->dropped_tasks(), 2u);
+
+    EXPECT_EQ(gated.finish(), "eab");
+}
+
+// Test that a task still queued at its deadline is dropped and counted
+TEST_F(ThreadPoolTest, DeadlineExpiredTasksDropped) {
+    for (auto mode : kAllModes) {
+        ThreadPool::Options options;
+        options.mode = mode;
+        GatedPool gated(options);
+
+        auto soon = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+        EXPECT_TRUE(gated.pool->submit_with_deadline(gated.record('e'), soon));
+        EXPECT_TRUE(gated.pool->submit(gated.record('n')));
+        EXPECT_TRUE(gated.pool->submit_with_deadline(gated.record('l'),
+                                                     soon + std::chrono::seconds(30)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+        EXPECT_EQ(gated.finish(), mode == ThreadPool::SchedulingMode::SharedQueue ? "ln" : "nl");
+        EXPECT_EQ(gated.pool->expired_tasks(), 1u);
+    }
+}
+
+// Test Block: an external submitter waits for room; shutdown releases waiters
+TEST_F(ThreadPoolTest, BoundedQueueBlock) {
+    for (auto mode : kAllModes) {
+        ThreadPool::Options options;
+        options.mode = mode;
+        options.capacity = 1;
+        options.overflow = ThreadPool::OverflowPolicy::Block;
+        GatedPool gated(options);
+
+        EXPECT_TRUE(gated.pool->submit(gated.record('a')));
+        std::atomic<bool> returned{false};
+        std::thread producer([&]() {
+            EXPECT_TRUE(gated.pool->submit(gated.record('b')));
+            returned = true;
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_FALSE(returned.load());
+        EXPECT_EQ(gated.pool->blocked_submissions(), 1u);
+
+        gated.gate.set_value();
+        producer.join();
+        EXPECT_TRUE(returned.load());
+        gated.pool->shutdown();
+        EXPECT_EQ(gated.order, "ab");
+    }
+}
+
+namespace {
+
+template <typename Pred>
+bool wait_until(Pred pred, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return true;
+}
+
+ThreadPool::Options elastic_options() {
+    ThreadPool::Options options;
+    options.threads = 1;
+    options.elastic = true;
+    options.min_threads = 1;
+    options.max_threads = 4;
+    options.grow_wait = std::chrono::microseconds(1000);
+    options.shrink_wait = std::chrono::microseconds(500);
+    options.resize_interval = std::chrono::milliseconds(5);
+    options.shrink_after = 2;
+    return options;
+}
+
+}  // namespace
+
+// Tasks stuck behind blocked workers raise queue wait, so the pool grows
+// up to max_threads; once the backlog clears it shrinks back to min_threads
+TEST_F(ThreadPoolTest, ElasticGrowsOnQueueWaitAndShrinksWhenIdle) {
+    ThreadPool pool(elastic_options());
+    ASSERT_TRUE(pool.is_elastic());
+    EXPECT_EQ(pool.size(), 1u);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> completed{0};
+    for (int i = 0; i < 8; ++i) {
+        pool.submit([released, &completed]() {
+            released.wait();
+            completed.fetch_add(1);
+        });
+    }
+
+    EXPECT_TRUE(wait_until([&]() { return pool.size() == 4; }));
+    EXPECT_GE(pool.grow_events(), 3u);
+    EXPECT_GE(pool.measured_queue_wait(), std::chrono::microseconds(1000));
+
+    release.set_value();
+    EXPECT_TRUE(wait_until([&]() { return completed.load() == 8; }));
+    EXPECT_TRUE(wait_until([&]() { return pool.size() == 1; }));
+    EXPECT_GE(pool.shrink_events(), 3u);
+
+    // Retired slots are reusable and the pool still drains on shutdown
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&completed]() { completed.fetch_add(1); });
+    }
+    pool.shutdown();
+    EXPECT_EQ(completed.load(), 108);
+}
+
+// Short tasks keep queue wait low: no growth even with a deep queue
+TEST_F(ThreadPoolTest, ElasticIgnoresQueueLength) {
+    auto options = elastic_options();
+    options.grow_wait = std::chrono::milliseconds(200);
+    ThreadPool pool(options);
+
+    std::atomic<int> completed{0};
+    for (int i = 0; i < 10000; ++i) {
+        pool.submit([&completed]() { completed.fetch_add(1); });
+    }
+    EXPECT_TRUE(wait_until([&]() { return completed.load() == 10000; }));
+    EXPECT_EQ(pool.grow_events(), 0u);
+    EXPECT_EQ(pool.size(), 1u);
+
+    // Not available in WorkStealing mode
+    options.mode = ThreadPool::SchedulingMode::WorkStealing;
+    ThreadPool stealing(options);
+    EXPECT_FALSE(stealing.is_elastic());
+    EXPECT_EQ(stealing.size(), 1u);
+}
+
+// Spin-then-park workers still run everything, pick up work that arrives
+// after they went idle, and do not hold up shutdown for the spin budget
+TEST_F(ThreadPoolTest, SpinThenParkIdleStrategy) {
+    for (auto mode : kAllModes) {
+        ThreadPool::Options options;
+        options.threads = 2;
+        options.mode = mode;
+        options.idle_spin = std::chrono::microseconds(200);
+        options.idle_yield = std::chrono::seconds(30);
+        ThreadPool pool(options);
+        ASSERT_TRUE(pool.spins_when_idle());
+
+        std::atomic<int> completed{0};
+        for (int round = 0; round < 20; ++round) {
+            for (int i = 0; i < 10; ++i) {
+                pool.submit([&completed]() { completed.fetch_add(1); });
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(300));
+        }
+        EXPECT_TRUE(wait_until([&]() { return completed.load() == 200; }));
+
+        auto start = std::chrono::steady_clock::now();
+        pool.shutdown();
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+        EXPECT_EQ(completed.load(), 200);
+    }
+}
+
+// Queue wait and run time land in the per-worker histograms
+TEST_F(ThreadPoolTest, TaskTimingsHistograms) {
+    for (auto mode : kAllModes) {
+        ThreadPool::Options options;
+        options.threads = 1;
+        options.mode = mode;
+        options.record_timings = true;
+        ThreadPool pool(options);
+        if (!pool.timing_enabled()) {
+            GTEST_SKIP() << "built with THREAD_POOL_TIMING=0";
+        }
+
+        // The second task waits behind the first one's 20 ms
+        pool.submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+        pool.submit([]() {});
+        pool.shutdown();
+
+        auto timings = pool.task_timings();
+        EXPECT_EQ(timings.run.count, 2u);
+        EXPECT_EQ(timings.queue_wait.count, 2u);
+        EXPECT_GE(timings.run.sum_ns, 20'000'000u);
+        EXPECT_GE(timings.queue_wait.sum_ns, 15'000'000u);
+
+        size_t slow_runs = 0;
+        for (size_t i = 0; i < ThreadPool::kTimingBuckets; ++i) {
+            if (ThreadPool::timing_bucket_bound_ns(i) > 16'000'000u) {
+                slow_runs += timings.run.buckets[i];
+            }
+        }
+        EXPECT_EQ(slow_runs, 1u);
+    }
+
+    ThreadPool untimed(1);
+    untimed.submit([]() {});
+    untimed.shutdown();
+    EXPECT_FALSE(untimed.timing_enabled());
+    EXPECT_EQ(untimed.task_timings().run.count, 0u);
+}
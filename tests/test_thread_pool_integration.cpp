@@ -85,7 +85,7 @@ TEST_F(ThreadPoolIntegrationTest, HighLoadPerformance) {
                 int work_amount = std::hash<std::string>{}(message) % 1000;
                 volatile int result = 0;
                 for (int i = 0; i < work_amount; ++i) {
-                    result += i;
+                    result = result + i;
                 }
                 
                 messages_processed.fetch_add(1);